@@ -0,0 +1,136 @@
+#include "process_event_hooks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// ProcessEvent detour lookup cost for calls of functions without handlers [almost every call in game]:
+// no lookup at all, the open addressed table the detour uses and std::unordered_map for comparison.
+//
+//   xmake build process-event-bench && xmake run process-event-bench [handlers, default 64]
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    uint64_t sink = 0;
+
+    // called through a pointer, the compiler can't fold the engine away from the proxies
+    void engine_process_event(const SDK::UObject *, SDK::UFunction *function, void *) {
+        sink += reinterpret_cast<uintptr_t>(function);
+    }
+
+    void (*volatile engine)(const SDK::UObject *, SDK::UFunction *, void *) = engine_process_event;
+
+    std::unordered_map<const SDK::UFunction *, process_event::Handlers> map_handlers;
+
+    void proxy_plain(const SDK::UObject *object, SDK::UFunction *function, void *params) {
+        engine(object, function, params);
+    }
+
+    // the detour's path, without the game thread pump
+    void proxy_table(const SDK::UObject *object, SDK::UFunction *function, void *params) {
+        process_event::quiescent();
+
+        auto handlers = process_event::find(function);
+
+        if (!handlers) [[likely]] {
+            engine(object, function, params);
+            return;
+        }
+
+        if (process_event::run_pre(*handlers, object, params)) {
+            engine(object, function, params);
+            process_event::run_post(*handlers, object, params);
+        }
+    }
+
+    void proxy_map(const SDK::UObject *object, SDK::UFunction *function, void *params) {
+        auto it = map_handlers.find(function);
+
+        if (it == map_handlers.end()) [[likely]] {
+            engine(object, function, params);
+            return;
+        }
+
+        if (process_event::run_pre(it->second, object, params)) {
+            engine(object, function, params);
+            process_event::run_post(it->second, object, params);
+        }
+    }
+
+    template<typename Proxy>
+    void run(const char *name, Proxy proxy, const std::vector<SDK::UFunction *> &calls, const SDK::UObject *object) {
+        double best = 1e9;
+
+        for (int round = 0; round < 15; round++) {
+            auto start = Clock::now();
+
+            for (auto function : calls) {
+                proxy(object, function, nullptr);
+            }
+
+            best = std::min(best, std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls.size());
+        }
+
+        std::printf("%-24s %.2f ns/call\n", name, best);
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    const int num_handlers = argc > 1 ? std::atoi(argv[1]) : 64;
+
+    // only the addresses matter, spread like GObjects allocations
+    std::vector<std::unique_ptr<std::byte[]>> storage;
+    std::vector<SDK::UFunction *>             functions;
+
+    for (int i = 0; i < 20000; i++) {
+        auto &memory = storage.emplace_back(std::make_unique<std::byte[]>(sizeof(SDK::UFunction)));
+        functions.push_back(reinterpret_cast<SDK::UFunction *>(memory.get()));
+    }
+
+    std::mt19937 random(1);
+    std::shuffle(functions.begin(), functions.end(), random);
+
+    for (int i = 0; i < num_handlers; i++) {
+        process_event::add_pre(functions[i], [](const SDK::UObject *, void *) {
+            return true;
+        });
+        map_handlers[functions[i]].pre.emplace_back(0, [](const SDK::UObject *, void *) {
+            return true;
+        });
+    }
+
+    // calls of functions without handlers, a working set of 2000 like a busy server frame
+    std::vector<SDK::UFunction *>      calls;
+    std::uniform_int_distribution<int> pick(num_handlers, num_handlers + 1999);
+
+    for (int i = 0; i < 1 << 20; i++) {
+        calls.push_back(functions[pick(random)]);
+    }
+
+    auto object_storage = std::make_unique<std::byte[]>(sizeof(SDK::UObject));
+    auto object         = reinterpret_cast<const SDK::UObject *>(object_storage.get());
+
+    run("no lookup", proxy_plain, calls, object);
+    run("open addressed table", proxy_table, calls, object);
+    run("std::unordered_map", proxy_map, calls, object);
+
+    const auto *table  = process_event::detail::current.load();
+    size_t      probes = 0;
+
+    for (auto function : calls) {
+        auto index = process_event::detail::slot_index(function, table->shift);
+
+        for (probes++; table->slots[index].function; probes++) {
+            index = (index + 1) & table->mask;
+        }
+    }
+
+    std::printf("%zu handlers, %zu slots, %.3f probes per call\n", static_cast<size_t>(num_handlers), table->mask + 1, static_cast<double>(probes) / calls.size());
+    return static_cast<int>(sink & 1);
+}
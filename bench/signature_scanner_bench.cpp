@@ -0,0 +1,129 @@
+#include "signature_scanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Signature scan throughput over a synthetic .text the size of the game's [several hundred MB]:
+// scan_patterns with every ResolveOffsets signature in one pass, and a plain byte by byte loop per pattern for comparison.
+//
+//   xmake build signature-scanner-bench && xmake run signature-scanner-bench [MB, default 512]
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // the ones offset_resolver.cpp scans for
+    const char *signatures[] = {
+        "48 8B 05 ?? ?? ?? ?? 48 8B 0C C8 48 8D 04 D1",
+        "48 8B 1D ?? ?? ?? ?? 48 85 DB 74 ?? 41 B0 01",
+        "48 89 5C 24 ?? 48 89 74 24 ?? 57 48 83 EC 20 80 3D ?? ?? ?? ?? ?? 48 8B FA 8B D9 74 ?? 4C 8D 44 24",
+        "40 55 56 57 41 54 41 55 41 56 41 57 48 81 EC ?? ?? ?? ?? 48 8D 6C 24 ?? 48 89 9D ?? ?? ?? ?? 48 8B 05 ?? ?? ?? ?? 48 33 C5 48 89 85 ?? ?? ?? ?? 8B 41 0C",
+        "48 89 5C 24 ?? 57 48 83 EC 20 0F B6 FA 48 8B D9 E8 ?? ?? ?? ?? F3 0F 58 05 ?? ?? ?? ?? 40 08 BB ?? ?? ?? ??",
+        "48 89 5C 24 ?? 48 89 74 24 ?? 57 48 83 EC 40 41 0F B6 F0 48 8B DA 48 8B F9 48 8B 89 ?? ?? ?? ?? 48 85 C9 74",
+        "48 89 5C 24 ?? 48 89 6C 24 ?? 48 89 74 24 ?? 57 48 83 EC 30 49 8B F0 48 8B EA E8 ?? ?? ?? ?? 48 8B D8 48 85 C0 74 ?? 48 8B C8 E8",
+        "48 83 EC 28 65 48 8B 04 25 58 00 00 00 8B 0D ?? ?? ?? ?? BA ?? ?? ?? ?? 48 8B 0C C8 8B 04 0A 39 05 ?? ?? ?? ?? 7F ?? 48 8D 05 ?? ?? ?? ?? 48 83 C4 28 C3",
+        "48 8B C4 55 53 56 57 41 54 41 55 41 56 41 57 48 8D A8 ?? ?? ?? ?? 48 81 EC ?? ?? ?? ?? 0F 29 70 ?? 48 8B 05 ?? ?? ?? ?? 48 33 C4 48 89 85 ?? ?? ?? ?? 4C 8B A5",
+        "B8 01 00 00 00 F0 0F C1 05 ?? ?? ?? ?? FF C0 8B C8 33 C0 F0 0F B1 4A 10",
+    };
+
+    // x64 code is full of the bytes the patterns start with, a uniform buffer would make every first byte check fail
+    const uint8_t common_bytes[] = { 0x48, 0x8B, 0x89, 0x8D, 0x85, 0x05, 0x0C, 0x24, 0x41, 0x4C, 0x83, 0xC4, 0xE8, 0xCC, 0x00, 0xFF };
+
+    std::vector<uint8_t> make_text(size_t size, std::mt19937 &random) {
+        std::vector<uint8_t>                    text(size);
+        std::uniform_int_distribution<uint32_t> pick;
+
+        for (size_t i = 0; i < size; i += 4) {
+            uint32_t bits = pick(random);
+
+            for (size_t b = 0; b < 4 && i + b < size; b++, bits >>= 8) {
+                // half the bytes from the common ones, the rest anything
+                text[i + b] = (bits & 0x80) ? common_bytes[bits & 0x0F] : static_cast<uint8_t>(bits >> 1);
+            }
+        }
+
+        return text;
+    }
+
+    // the naive scan ResolveOffsets replaced, one full pass per pattern
+    const uint8_t *naive_find(const uint8_t *data, size_t size, const BytePattern &pattern) {
+        for (size_t i = 0; i + pattern.size() <= size; i++) {
+            size_t j = 0;
+            while (j < pattern.size() && (data[i + j] & pattern.mask[j]) == pattern.bytes[j]) {
+                j++;
+            }
+
+            if (j == pattern.size()) {
+                return data + i;
+            }
+        }
+
+        return nullptr;
+    }
+
+    double gigabytes_per_second(size_t bytes, Clock::duration elapsed) {
+        return bytes / std::chrono::duration<double>(elapsed).count() / 1e9;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    const size_t size = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 512) << 20;
+
+    std::vector<BytePattern> patterns;
+    for (auto text : signatures) {
+        patterns.push_back(*BytePattern::parse(text));
+    }
+
+    std::mt19937 random(1);
+    auto         text = make_text(size, random);
+
+    // every pattern once, spread over the buffer, wildcards filled with noise
+    std::vector<size_t> planted;
+
+    for (size_t p = 0; p < patterns.size(); p++) {
+        auto &pattern = patterns[p];
+        auto  at      = size / (patterns.size() + 1) * (p + 1) + random() % 4096;
+
+        for (size_t j = 0; j < pattern.size(); j++) {
+            text[at + j] = pattern.mask[j] ? pattern.bytes[j] : static_cast<uint8_t>(random());
+        }
+
+        planted.push_back(at);
+    }
+
+    std::printf("%zu MB, %zu patterns, %s\n", size >> 20, patterns.size(), scanner_uses_avx2() ? "AVX2" : "SSE2");
+
+    int failed = 0;
+
+    auto best = Clock::duration::max();
+    for (int round = 0; round < 5; round++) {
+        auto start   = Clock::now();
+        auto matches = scan_patterns(text.data(), text.size(), patterns);
+        best         = std::min(best, Clock::now() - start);
+
+        for (size_t p = 0; p < patterns.size(); p++) {
+            if (matches[p].count != 1 || matches[p].first != text.data() + planted[p]) {
+                std::printf("scan_patterns: pattern %zu matched %zu times\n", p, matches[p].count);
+                failed = 1;
+            }
+        }
+    }
+
+    std::printf("%-24s %8.1f ms %6.2f GB/s\n", "scan_patterns", std::chrono::duration<double, std::milli>(best).count(), gigabytes_per_second(size, best));
+
+    auto start = Clock::now();
+    for (size_t p = 0; p < patterns.size(); p++) {
+        if (naive_find(text.data(), text.size(), patterns[p]) != text.data() + planted[p]) {
+            std::printf("naive: pattern %zu not found at its offset\n", p);
+            failed = 1;
+        }
+    }
+    auto naive = Clock::now() - start;
+
+    std::printf("%-24s %8.1f ms %6.2f GB/s\n", "naive, pass per pattern", std::chrono::duration<double, std::milli>(naive).count(), gigabytes_per_second(size, naive));
+    return failed;
+}
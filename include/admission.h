@@ -0,0 +1,53 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// What a request costs, every client has one token bucket per cost
+enum class RequestCost {
+    read,  // served from the world snapshot or a cache, never waits for the game thread
+    write, // runs on the game thread, also takes from the bucket shared by every client
+};
+
+struct AdmissionOptions {
+        // per client, tokens per second and bucket size, a rate of 0 turns the limit off
+        double read_rate   = 50;
+        double read_burst  = 100;
+        double write_rate  = 5;
+        double write_burst = 20;
+
+        // every client together, game thread tasks per dispatcher window [about a frame], 0 for no limit
+        double                    game_thread_tasks = 8;
+        std::chrono::microseconds window            = std::chrono::microseconds(16000);
+
+        // API tokens [Authorization header] that get buckets of their own, on top of their address's
+        std::vector<std::string> tokens;
+};
+
+struct Admission {
+        bool                      admitted;
+        std::chrono::milliseconds retry_after;   // until the buckets hold enough tokens, if not admitted
+        bool                      never = false; // more than a bucket can ever hold, retrying won't help [413]
+
+        explicit operator bool() const {
+            return admitted;
+        }
+};
+
+// Token bucket admission control for the HTTP API and RCON. A client that floods the API gets 429 [or an RCON
+// error] right away instead of queueing work faster than the game thread runs it. Safe from any thread.
+namespace admission {
+    // configure - once at startup, before the servers accept anything
+    void configure(const AdmissionOptions &options);
+
+    // admit - takes tokens [a batch pays per command] from the bucket for cost of the client's address and of its
+    // token if that is a configured one. A write that is a game thread task also takes one from the global bucket,
+    // a batch is one task however many commands it runs. Nothing is taken unless every bucket has enough.
+    // More than max_tokens(cost) is never admitted.
+    Admission admit(std::string_view address, std::string_view token, RequestCost cost, double tokens = 1, bool game_thread_task = true);
+
+    // max_tokens - the most one request of this cost can ask for, the client bucket size
+    double max_tokens(RequestCost cost);
+} // namespace admission
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "SDK.hpp"
+#include "engine_functions.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct SDKContext {
+        SDK::UEngine              *engine;
+        SDK::UWorld               *world;
+        SDK::UPalUtility          *utility;
+        SDK::APalGameStateInGame  *stateInGame;
+        ForceGarbageCollectionType forceGarbageCollection;
+
+        SDKContext(SDK::UEngine *eng, SDK::UWorld *wrld, SDK::UPalUtility *util, SDK::APalGameStateInGame *state, ForceGarbageCollectionType fgc)
+            : engine(eng), world(wrld), utility(util), stateInGame(state), forceGarbageCollection(fgc) {}
+};
+
+// Commands touch game objects, call them on the game thread [game_thread::post]. Strings are UTF-8.
+
+enum class CommandKind {
+    state,
+    broadcast,
+    gc,
+    list,
+    kick,
+};
+
+// One command line, parsed and checked without touching the game
+struct ParsedCommand {
+        CommandKind kind;
+        std::string argument; // broadcast text, kick UID
+};
+
+// parse_command - nullopt for an unknown command, a missing argument or a malformed UID, error says which. Safe on any thread.
+std::optional<ParsedCommand> parse_command(std::string_view text, std::string *error = nullptr);
+
+// Online players by UID, read from GameState->PlayerArray on first use and shared by every command of a batch.
+// Game thread only, like the commands.
+class PlayerIndex {
+    public:
+        explicit PlayerIndex(const SDKContext &in_context) : context(in_context) {}
+
+        // find - player state of the online player whose UID prints as uid_text ["0123abcd"]
+        SDK::APalPlayerState *find(std::string_view uid_text);
+
+        // remove - a kicked player stays in PlayerArray until the connection is gone, later commands must not see it
+        void remove(SDK::APalPlayerState *state);
+
+    private:
+        void build();
+
+        const SDKContext                                   &context;
+        bool                                                built = false;
+        std::unordered_map<uint32_t, SDK::APalPlayerState *> players;
+};
+
+std::string command_state(const SDKContext &context);
+std::string command_broadcast(const SDKContext &context, const std::string &message);
+std::string command_gc(const SDKContext &context);
+std::string command_list(const SDKContext &context);
+
+// command_player / command_kick - nullopt if no online player has this UID ["0123abcd"]
+std::optional<std::string> command_player(const SDKContext &context, const std::string &uid_text);
+std::optional<std::string> command_kick(const SDKContext &context, const std::string &uid_text);
+std::optional<std::string> command_kick(const SDKContext &context, PlayerIndex &players, std::string_view uid_text);
+
+// player_address - remote address of a connected player ["1.2.3.4:8211"], "[UNK]" if it has no connection
+std::string player_address(SDK::APlayerController *controller);
+
+// run_command - runs a parsed command and returns its reply, players is shared with the other commands of a batch
+std::string run_command(const ParsedCommand &command, const SDKContext &context, PlayerIndex &players);
+
+// execute_command - runs one console/rcon command line ["state", "broadcast <text>", "gc", "list", "kick <uid>"] and returns its reply
+std::string execute_command(const std::string &text, const SDKContext &context);
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "http_server.h"
+#include "json_writer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Game events for external tools, served as a WebSocket stream on GET /events.
+//
+// Producers [the game thread, in practice] serialize each event once into a ring of the last EventCapacity events.
+// Every subscriber keeps its own cursor into the ring and sends the shared payloads as they are, so a subscriber
+// that falls behind only loses events, it never slows the producer down.
+
+enum class EventType : uint8_t {
+    Login,
+    Logout,
+    Chat,
+    Kick,
+    Broadcast,
+    Num,
+};
+
+// event_type_name - "login", "logout", "chat", "kick", "broadcast"
+const char *event_type_name(EventType type);
+
+// parse_event_types - bit mask from a comma separated list ["login,chat"], nullopt on an unknown name
+std::optional<uint32_t> parse_event_types(std::string_view names);
+
+constexpr uint32_t AllEventTypes = (1u << static_cast<uint32_t>(EventType::Num)) - 1;
+
+struct Event {
+        uint64_t    sequence;
+        EventType   type;
+        std::string json;
+};
+
+namespace events {
+    constexpr uint64_t EventCapacity = 4096;
+
+    // start - wake-ups for subscribers are posted to executor [the HTTP server's io_context]
+    void start(net::any_io_executor executor);
+
+    // push - appends an event, fields is the tail of its JSON object [",\"name\":\"x\""] after seq, type and time_ms
+    void push(EventType type, std::string_view fields);
+
+    // head - sequence of the next event to be pushed
+    uint64_t head();
+
+    // get - the event with this sequence, nullptr if it was overwritten or isn't pushed yet
+    std::shared_ptr<const Event> get(uint64_t sequence);
+
+    // publish - serializes one event, fill adds its own fields to the event object:
+    //   events::publish(EventType::Kick, [&](JsonWriter &json) { json.field("name", name); });
+    template<typename Fn>
+    void publish(EventType type, Fn &&fill) {
+        std::string fields;
+        JsonWriter  json(fields);
+
+        // fields continue the object push() opens
+        json.reset_separator(false);
+        fill(json);
+
+        push(type, fields);
+    }
+
+    // accept_subscriber - finishes the WebSocket handshake and streams events matching type_mask from now on
+    void accept_subscriber(tcp::socket &&socket, HttpRequest &&request, uint32_t type_mask);
+
+    // num_subscribers - connected WebSocket subscribers
+    size_t num_subscribers();
+} // namespace events
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "SDK.hpp"
+
+// Fields read by the loader, resolved against the running game by SDK::FRuntimeFields::Resolve().
+// Prefer these over direct member access so a game patch that moves a field doesn't need a re-dump.
+
+SDK_RUNTIME_FIELD(APalGameStateInGame, WorldSaveDirectoryName);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ServerWildMonsterCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ServerOtomoMonsterCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ServerBaseCampMonsterCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ServerNPCCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ServerOtherCharacterCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, BaseCampCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, NavMeshInvokerCount);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_AllUpdate);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_Nearest);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_Near);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_MidInSight);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_FarInSight);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_MidOutSight);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_FarOutSight);
+SDK_RUNTIME_FIELD(APalGameStateInGame, ImportanceCharacterCount_Farthest);
+
+SDK_RUNTIME_FIELD(APalPlayerState, PlayerUId);
+SDK_RUNTIME_FIELD(APalPlayerState, LoginTryingPlayerUId_InServer);
+SDK_RUNTIME_FIELD(APalPlayerState, CachedPlayerLocation);
+SDK_RUNTIME_FIELD(APalPlayerState, GuildBelongTo);
+
+SDK_RUNTIME_FIELD(UPalGroupGuildBase, GuildName);
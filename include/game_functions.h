@@ -0,0 +1,85 @@
+#pragma once
+
+#include "SDK.hpp"
+
+// UFunctions called by the loader, through FFunctionTable [SDK_FUNCTION_LIST] and the dumped SDK::Params structs.
+// The SDK wrappers find their UFunction by name on first call; these were resolved at startup and checked then.
+// Static functions [UPalUtility] are called on the class default object, like the SDK wrappers do.
+namespace game_functions {
+    inline SDK::FString get_world_name(const SDK::APalGameStateInGame *state) {
+        SDK::Params::APalGameStateInGame_GetWorldName_Params params {};
+        SDK::CallFunction(state, SDK::EFunctionId::PalGameStateInGame_GetWorldName, params);
+        return params.ReturnValue;
+    }
+
+    inline float get_server_frame_time(const SDK::APalGameStateInGame *state) {
+        SDK::Params::APalGameStateInGame_GetServerFrameTime_Params params {};
+        SDK::CallFunction(state, SDK::EFunctionId::PalGameStateInGame_GetServerFrameTime, params);
+        return params.ReturnValue;
+    }
+
+    inline int32_t get_max_player_num(const SDK::APalGameStateInGame *state) {
+        SDK::Params::APalGameStateInGame_GetMaxPlayerNum_Params params {};
+        SDK::CallFunction(state, SDK::EFunctionId::PalGameStateInGame_GetMaxPlayerNum, params);
+        return params.ReturnValue;
+    }
+
+    inline void send_system_announce(const SDK::UPalUtility *utility, SDK::UObject *world, const SDK::FString &message) {
+        SDK::Params::UPalUtility_SendSystemAnnounce_Params params {};
+        params.WorldContextObject = world;
+        params.Message            = message;
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_SendSystemAnnounce, params);
+    }
+
+    inline SDK::APalGameStateInGame *get_pal_game_state_in_game(const SDK::UPalUtility *utility, SDK::UObject *world) {
+        SDK::Params::UPalUtility_GetPalGameStateInGame_Params params {};
+        params.WorldContextObject = world;
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_GetPalGameStateInGame, params);
+        return params.ReturnValue;
+    }
+
+    inline bool is_development_build(const SDK::UPalUtility *utility) {
+        SDK::Params::UPalUtility_IsDevelopmentBuild_Params params {};
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_IsDevelopmentBuild, params);
+        return params.ReturnValue;
+    }
+
+    inline SDK::TArray<SDK::APalCharacter *> get_all_player_characters(const SDK::UPalUtility *utility, SDK::UObject *world) {
+        SDK::Params::UPalUtility_GetAllPlayerCharacters_Params params {};
+        params.WorldContextObject = world;
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_GetAllPlayerCharacters, params);
+        return params.OutPlayers;
+    }
+
+    inline SDK::APalPlayerState *get_player_state_by_player(const SDK::UPalUtility *utility, SDK::APalPlayerCharacter *player) {
+        SDK::Params::UPalUtility_GetPlayerStateByPlayer_Params params {};
+        params.Player = player;
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_GetPlayerStateByPlayer, params);
+        return params.ReturnValue;
+    }
+
+    inline SDK::FGuid get_player_uid_by_actor(const SDK::UPalUtility *utility, SDK::AActor *actor) {
+        SDK::Params::UPalUtility_GetPlayerUIDByActor_Params params {};
+        params.PlayerActor = actor;
+        SDK::CallFunction(utility, SDK::EFunctionId::PalUtility_GetPlayerUIDByActor, params);
+        return params.ReturnValue;
+    }
+
+    inline SDK::FString get_player_name(const SDK::APlayerState *state) {
+        SDK::Params::APlayerState_GetPlayerName_Params params {};
+        SDK::CallFunction(state, SDK::EFunctionId::PlayerState_GetPlayerName, params);
+        return params.ReturnValue;
+    }
+
+    inline int32_t get_player_id(const SDK::APlayerState *state) {
+        SDK::Params::APlayerState_GetPlayerId_Params params {};
+        SDK::CallFunction(state, SDK::EFunctionId::PlayerState_GetPlayerId, params);
+        return params.ReturnValue;
+    }
+
+    inline SDK::AController *get_controller(const SDK::APawn *pawn) {
+        SDK::Params::APawn_GetController_Params params {};
+        SDK::CallFunction(pawn, SDK::EFunctionId::Pawn_GetController, params);
+        return params.ReturnValue;
+    }
+} // namespace game_functions
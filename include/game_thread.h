@@ -0,0 +1,147 @@
+#pragma once
+
+#include "mpsc_queue.h"
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+
+#include <chrono>
+#include <exception>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+// Runs work on the game thread. Anything that touches UObjects from another thread (HTTP, console, plugins)
+// goes through here instead of calling into the engine directly.
+//
+// The ProcessEvent hook pumps the queue, spending at most the configured budget per window so a burst of
+// commands can't stall a frame. Work posted from the game thread itself, or when nothing will ever pump the queue
+// (hooks not installed), runs inline.
+namespace game_thread {
+    struct Task : MpscNode {
+            virtual ~Task()    = default;
+            virtual void run() = 0;
+
+            std::chrono::steady_clock::time_point enqueued_at; // set by enqueue(), for the queue wait metric
+    };
+
+    template<typename Fn>
+    struct FunctionTask : Task {
+            Fn fn;
+
+            explicit FunctionTask(Fn &&in_fn) : fn(std::move(in_fn)) {}
+
+            void run() override {
+                fn();
+            }
+    };
+
+    // attach_current_thread - called from the game thread once, by the hook that identifies it
+    void attach_current_thread();
+    bool is_attached();
+    bool is_game_thread();
+
+    // expect_attach - the pumping hook is installed, work queues from now on even before the game thread attached
+    void expect_attach();
+    bool is_queueing();
+
+    void set_budget(std::chrono::microseconds budget, std::chrono::microseconds window);
+
+    // pump - runs queued tasks within the budget, no-op off the game thread or when nested in a running task
+    void pump();
+
+    // enqueue - takes ownership, the task is deleted after it ran
+    void enqueue(Task *task);
+
+    template<typename Fn>
+    void run_or_enqueue(Fn &&fn) {
+        if (!is_queueing() || is_game_thread()) {
+            fn();
+            return;
+        }
+
+        enqueue(new FunctionTask<std::decay_t<Fn>>(std::forward<Fn>(fn)));
+    }
+
+    // post - runs fn on the game thread, the future gets its result or exception
+    template<typename Fn>
+    auto post(Fn &&fn) -> std::future<std::invoke_result_t<std::decay_t<Fn>>> {
+        using ResultType = std::invoke_result_t<std::decay_t<Fn>>;
+
+        std::promise<ResultType> promise;
+        auto                     future = promise.get_future();
+
+        run_or_enqueue([promise = std::move(promise), fn = std::forward<Fn>(fn)]() mutable {
+            try {
+                if constexpr (std::is_void_v<ResultType>) {
+                    fn();
+                    promise.set_value();
+                } else {
+                    promise.set_value(fn());
+                }
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        });
+
+        return future;
+    }
+
+    namespace detail {
+        template<typename ResultType>
+        struct completion_signature {
+                using type = void(std::exception_ptr, ResultType);
+        };
+
+        template<>
+        struct completion_signature<void> {
+                using type = void(std::exception_ptr);
+        };
+    } // namespace detail
+
+    // async_post - asio flavour of post(), the handler runs on its own executor.
+    // Completes with (std::exception_ptr, result), works with use_awaitable, use_future and plain callbacks.
+    // A non-void result must be default constructible.
+    template<typename Fn, typename CompletionToken>
+    auto async_post(Fn &&fn, CompletionToken &&token) {
+        using ResultType = std::invoke_result_t<std::decay_t<Fn>>;
+        using Signature  = typename detail::completion_signature<ResultType>::type;
+
+        return boost::asio::async_initiate<CompletionToken, Signature>(
+            [](auto handler, auto fn) {
+                auto work = boost::asio::make_work_guard(boost::asio::get_associated_executor(handler));
+
+                run_or_enqueue([handler = std::move(handler), fn = std::move(fn), work = std::move(work)]() mutable {
+                    std::exception_ptr error;
+
+                    if constexpr (std::is_void_v<ResultType>) {
+                        try {
+                            fn();
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+
+                        boost::asio::post(work.get_executor(), [handler = std::move(handler), error]() mutable {
+                            handler(error);
+                        });
+                    } else {
+                        std::optional<ResultType> result;
+
+                        try {
+                            result.emplace(fn());
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+
+                        boost::asio::post(work.get_executor(), [handler = std::move(handler), error, result = std::move(result)]() mutable {
+                            handler(error, result ? std::move(*result) : ResultType {});
+                        });
+                    }
+                });
+            },
+            token, std::forward<Fn>(fn));
+    }
+} // namespace game_thread
@@ -3,8 +3,19 @@
 
 typedef SDK::APlayerController *(*SpawnPlayActorType)(SDK::UWorld *that, SDK::UPlayer *player, SDK::ENetRole role, const SDK::FURL *url, const SDK::FUniqueNetIdRepl *uid, SDK::FString *error, uint8_t index);
 
+typedef void (*ProcessEventType)(const SDK::UObject *object, SDK::UFunction *function, void *params);
+
 extern SpawnPlayActorType engine_spawn_play_actor;
+extern ProcessEventType   engine_process_event;
+
+// game_thread_id - set by install_hooks before the ProcessEvent hook goes live [GetGameThreadId]
+extern uint32_t game_thread_id;
 
 SDK::APlayerController *spawn_play_actor_proxy(SDK::UWorld *that, SDK::UPlayer *player, SDK::ENetRole role, const SDK::FURL *url, const SDK::FUniqueNetIdRepl *uid, SDK::FString *error, uint8_t index);
 
+void process_event_proxy(const SDK::UObject *object, SDK::UFunction *function, void *params);
+
+// register_event_handlers - the loader's own ProcessEvent handlers [process_event_hooks.h], chat and logout events
+void register_event_handlers();
+
 bool install_hooks();
\ No newline at end of file
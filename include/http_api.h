@@ -0,0 +1,19 @@
+#pragma once
+
+#include "commands.h"
+#include "http_router.h"
+
+#include <memory>
+
+// register_http_routes - the loader's HTTP API
+//   GET  /world/state           GET  /players               GET /players/{uid}
+//   POST /world/broadcast?message=...                       POST /players/{uid}/kick
+//   POST /world/gc              GET  /rcon?text=<command>   [console command line, kept for old scripts]
+//   POST /batch                 [body: one command line per line, all run in one game thread task, JSON results in order]
+//   GET  /metrics               [Prometheus text: per route and per command latency histograms, game thread queue wait, connections]
+//   GET  /telemetry?base=<sequence>                         [binary frame, delta against base if given, see telemetry.h]
+//   GET  /objects?class=<Name>  [chunked dump of GObjects, optionally only instances of a class]
+//   GET  /events?types=login,logout,chat,kick,broadcast     [WebSocket, JSON arrays of events]
+// Everything but /rcon and the POST acknowledgements answers JSON, gzip/deflate compressed past the threshold when accepted.
+// Routes that run on the game thread are rate limited as writes, the rest as reads; over the limit they answer 429.
+void register_http_routes(HttpRouter &router, std::shared_ptr<SDKContext> sdkContext);
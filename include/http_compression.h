@@ -0,0 +1,53 @@
+#pragma once
+
+#include <boost/beast/zlib/deflate_stream.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Content codings the HTTP API can answer with [Accept-Encoding / Content-Encoding]
+enum class ContentCoding : uint8_t {
+    identity,
+    gzip,
+    deflate, // zlib wrapped [RFC 1950], what HTTP means by "deflate"
+};
+
+namespace http_compression {
+    // configure - bodies shorter than min_bytes go out as they are, level is zlib's 1 [fast] .. 9 [small]
+    void configure(size_t min_bytes, int level);
+
+    size_t min_bytes();
+
+    // negotiate - the coding to answer with for an Accept-Encoding header, gzip wins ties, "q=0" excludes a coding
+    ContentCoding negotiate(std::string_view accept_encoding);
+
+    // name - Content-Encoding token ["gzip"], empty for identity
+    std::string_view name(ContentCoding coding);
+
+    // compress - the whole body in one go
+    std::string compress(std::string_view body, ContentCoding coding);
+} // namespace http_compression
+
+// Compresses a body that arrives in pieces [chunked responses]. Every write() flushes, so each piece
+// the client receives decodes on its own instead of waiting for the end of the stream.
+// The deflate state comes from a small per-thread pool and goes back to the pool of whichever thread destroys it.
+class StreamCompressor {
+    public:
+        explicit StreamCompressor(ContentCoding in_coding);
+        ~StreamCompressor();
+
+        StreamCompressor(const StreamCompressor &)            = delete;
+        StreamCompressor &operator=(const StreamCompressor &) = delete;
+
+        // write - appends the compressed input to out, finish also writes the end of the stream and its trailer
+        void write(std::string_view input, std::string &out, bool finish);
+
+    private:
+        std::unique_ptr<boost::beast::zlib::deflate_stream> stream;
+        ContentCoding                                       coding;
+        bool                                                started  = false;
+        uint32_t                                            checksum = 0; // crc32 for gzip, adler32 for deflate
+        uint32_t                                            size     = 0; // input bytes mod 2^32 [gzip ISIZE]
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "admission.h"
+#include "http_server.h"
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Query string view ["a=1&text=hello%20world"], nothing is copied or decoded until a value is asked for.
+class QueryString {
+    public:
+        QueryString() = default;
+        explicit QueryString(std::string_view in_query) : query(in_query) {}
+
+        // raw - value as it appears in the target, still percent-encoded
+        std::optional<std::string_view> raw(std::string_view key) const;
+
+        // get - decoded value ["+" -> " ", "%41" -> "A"]
+        std::optional<std::string> get(std::string_view key) const;
+
+        bool contains(std::string_view key) const {
+            return raw(key).has_value();
+        }
+
+        static std::string decode(std::string_view value);
+
+    private:
+        std::string_view query;
+};
+
+struct RouteMatch {
+        static constexpr size_t max_params = 4;
+
+        std::array<std::pair<std::string_view, std::string_view>, max_params> params;
+        size_t                                                                num_params = 0;
+        QueryString                                                           query;
+
+        // param - path parameter by name ["/players/{uid}" -> param("uid")], empty if there is none
+        std::string_view param(std::string_view name) const {
+            for (size_t i = 0; i < num_params; i++) {
+                if (params[i].first == name) {
+                    return params[i].second;
+                }
+            }
+            return {};
+        }
+};
+
+// Views in the match point into request.target(), read what you need before moving the request.
+using RouteHandler = std::function<void(HttpRequest &request, const RouteMatch &match, HttpResponder responder)>;
+
+// api_token - the request's Authorization token without "Bearer ", empty if it has none. Only rate limiting looks at it.
+std::string_view api_token(const HttpRequest &request);
+
+// refused_response - reply for a request admission turned down, 413 if it never will admit it, 429 otherwise
+http::response<http::string_body> refused_response(const HttpRequest &request, const Admission &admission);
+
+// Segment trie over route patterns ["/players/{uid}/kick"], literal segments win over parameters.
+// Routes are added at startup, dispatch() is read-only and safe from every I/O thread.
+// Every route times its requests into pal_http_request_duration_seconds{method,route} [metrics.h].
+// Every route takes a token of its cost from the client [admission.h] before its handler runs, or answers 429.
+class HttpRouter {
+    public:
+        HttpRouter();
+
+        void add(http::verb method, std::string_view pattern, RouteHandler handler) {
+            add(method, pattern, RequestCost::read, std::move(handler));
+        }
+
+        // add - cost is write for handlers that run anything on the game thread
+        void add(http::verb method, std::string_view pattern, RequestCost cost, RouteHandler handler);
+
+        // dispatch - runs the matching handler, or answers 404 / 405 itself
+        void dispatch(HttpRequest &&request, HttpResponder responder) const;
+
+    private:
+        struct Route {
+                http::verb        method;
+                RouteHandler      handler;
+                LatencyHistogram *latency;
+                RequestCost       cost;
+        };
+
+        struct Node {
+                std::vector<std::pair<std::string, size_t>> children; // literal segment -> node
+                size_t                                      param_child = 0;
+                std::string                                 param_name;
+                std::vector<Route>                          handlers;
+        };
+
+        const Node *find(std::string_view path, RouteMatch &match) const;
+
+        std::vector<Node> nodes; // nodes[0] is the root, index 0 as a child means none
+        LatencyHistogram *unmatched_latency; // 404 and 405 answers, method="" route=""
+};
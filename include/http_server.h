@@ -0,0 +1,256 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "http_compression.h"
+#include "metrics.h"
+
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+
+namespace net   = boost::asio;  // from <boost/asio.hpp>
+namespace beast = boost::beast; // from <boost/beast.hpp>
+namespace http  = beast::http;  // from <boost/beast/http.hpp>
+using tcp       = net::ip::tcp; // from <boost/asio/ip/tcp.hpp>
+
+using HttpRequest = http::request<http::string_body>;
+
+// Connections from the same host [HttpServerOptions::local_path], a named pipe on Windows, an AF_UNIX socket elsewhere
+#ifdef _WIN32
+using LocalStream = net::windows::stream_handle;
+#else
+using LocalStream = beast::basic_stream<net::local::stream_protocol>;
+#endif
+
+// One queued response. Sessions write them strictly in request order, whatever order handlers finish in.
+// A session writes to one of two stream types, writers implement both [usually through one template].
+struct HttpResponseWriter {
+        using Done = std::function<void(beast::error_code)>;
+
+        virtual ~HttpResponseWriter() = default;
+
+        virtual bool keep_alive() const = 0;
+
+        // set by the session before async_write, a writer that writes piece by piece renews the deadline with it before each piece
+        std::chrono::seconds write_timeout {};
+
+        // async_write - writes the whole response, then calls done exactly once
+        virtual void async_write(beast::tcp_stream &stream, Done done) = 0;
+        virtual void async_write(LocalStream &stream, Done done)       = 0;
+};
+
+template<class Body>
+struct HttpMessageWriter : HttpResponseWriter {
+        http::response<Body> message;
+
+        explicit HttpMessageWriter(http::response<Body> &&in_message) : message(std::move(in_message)) {}
+
+        bool keep_alive() const override {
+            return message.keep_alive();
+        }
+
+        void async_write(beast::tcp_stream &stream, Done done) override {
+            write_to(stream, std::move(done));
+        }
+
+        void async_write(LocalStream &stream, Done done) override {
+            write_to(stream, std::move(done));
+        }
+
+    private:
+        template<class Stream>
+        void write_to(Stream &stream, Done done) {
+            http::async_write(stream, message, [done = std::move(done)](beast::error_code ec, std::size_t bytes) {
+                metrics::http_bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+                done(ec);
+            });
+        }
+};
+
+// Sends a body owned by someone else [a cached response] without copying it, owner keeps the bytes alive until written
+struct HttpSharedBodyWriter : HttpMessageWriter<http::span_body<const char>> {
+        std::shared_ptr<const void> owner;
+
+        HttpSharedBodyWriter(http::response<http::span_body<const char>> &&in_message, std::shared_ptr<const void> in_owner)
+            : HttpMessageWriter(std::move(in_message)), owner(std::move(in_owner)) {}
+};
+
+// produce - appends the next piece of the body to chunk, then calls next(finished) once, from any thread
+using HttpChunkProducer = std::function<void(std::string &chunk, std::function<void(bool finished)> next)>;
+
+// Streams a body with chunked transfer encoding, the whole body never sits in memory at once.
+// The header goes out with the first chunk, a producer that fails can only end the stream.
+// With a coding [negotiated from the request] every chunk is compressed, unless the whole body fits in one short chunk.
+// HTTP/1.0 clients can't decode chunks, they get the plain body and the connection closes after it.
+struct HttpChunkedWriter : HttpResponseWriter {
+        http::response<http::empty_body> header;
+
+        HttpChunkedWriter(http::response<http::empty_body> &&in_header, HttpChunkProducer in_produce, ContentCoding in_coding = ContentCoding::identity)
+            : header(std::move(in_header)), produce(std::move(in_produce)), coding(in_coding) {
+            if (header.version() >= 11) {
+                header.chunked(true);
+            } else {
+                header.keep_alive(false);
+            }
+        }
+
+        bool keep_alive() const override {
+            return header.keep_alive();
+        }
+
+        void async_write(beast::tcp_stream &stream, Done done) override;
+        void async_write(LocalStream &stream, Done done) override;
+
+    private:
+        void next_chunk();
+        void write_chunk(bool finished);
+        void finish(beast::error_code ec);
+
+        HttpChunkProducer                                          produce;
+        ContentCoding                                              coding;
+        std::optional<StreamCompressor>                            compressor;
+        std::optional<http::response_serializer<http::empty_body>> serializer;
+        std::string                                                chunk;
+        std::string                                                encoded;
+        std::variant<beast::tcp_stream *, LocalStream *>           stream;
+        Done                                                       done;
+};
+
+// Hands the connection over to another protocol [WebSocket] once every earlier response is written.
+// The HTTP session ends there, accept owns the socket and gets the upgrade request to answer.
+// Only TCP connections can be handed over, a local connection gets 501 and closes.
+struct HttpUpgradeWriter : HttpResponseWriter {
+        using Accept = std::function<void(tcp::socket &&socket, HttpRequest &&request)>;
+
+        HttpUpgradeWriter(HttpRequest &&in_request, Accept in_accept) : request(std::move(in_request)), accept(std::move(in_accept)) {}
+
+        bool keep_alive() const override {
+            return false;
+        }
+
+        void async_write(beast::tcp_stream &stream, Done done) override {
+            accept(stream.release_socket(), std::move(request));
+            done({});
+        }
+
+        void async_write(LocalStream &stream, Done done) override;
+
+    private:
+        HttpRequest                         request;
+        Accept                              accept;
+        std::unique_ptr<HttpResponseWriter> refusal;
+};
+
+// A connection serving HTTP requests, over TCP or a local stream
+class HttpSession {
+    public:
+        virtual ~HttpSession() = default;
+
+        virtual void fulfill(uint64_t slot, std::unique_ptr<HttpResponseWriter> writer) = 0;
+
+        virtual net::any_io_executor executor() = 0;
+
+        // client_address - remote address without the port ["1.2.3.4"], "local" for a pipe or unix socket
+        virtual const std::string &client_address() const = 0;
+};
+
+// HttpResponder - answers one request. Copyable, may be used from any thread, the first send() wins.
+class HttpResponder {
+    public:
+        HttpResponder(std::shared_ptr<HttpSession> in_session, uint64_t in_slot)
+            : session(std::move(in_session)), slot(in_slot), received(std::chrono::steady_clock::now()) {}
+
+        // observe - send() records the time since the request was read into latency [the router's per route histogram]
+        void observe(LatencyHistogram &in_latency) {
+            latency = &in_latency;
+        }
+
+        void send(std::unique_ptr<HttpResponseWriter> writer) const;
+
+        template<class Body>
+        void send(http::response<Body> &&message) const {
+            send(std::make_unique<HttpMessageWriter<Body>>(std::move(message)));
+        }
+
+        // executor - the session's strand, completions bound to it run in order with the session
+        net::any_io_executor executor() const;
+
+        const std::string &client_address() const;
+
+    private:
+        std::shared_ptr<HttpSession>          session;
+        uint64_t                              slot;
+        std::chrono::steady_clock::time_point received;
+        LatencyHistogram                     *latency = nullptr;
+};
+
+// Handlers run on an I/O thread and must not block it, slow work answers later through the responder.
+using HttpHandler = std::function<void(HttpRequest &&request, HttpResponder responder)>;
+
+struct HttpServerOptions {
+        std::string          address        = "127.0.0.1";
+        unsigned short       port           = 53000;
+        std::string          local_path; // also listen here if set, "\\.\pipe\pal_loader" on Windows, a socket path elsewhere
+        int                  threads        = 2;
+        size_t               pipeline_limit = 16; // responses queued per connection before reading pauses
+        std::chrono::seconds idle_timeout   = std::chrono::seconds(30);
+};
+
+class HttpServer {
+    public:
+        HttpServer(HttpServerOptions options, HttpHandler handler);
+        ~HttpServer();
+
+        HttpServer(const HttpServer &)            = delete;
+        HttpServer &operator=(const HttpServer &) = delete;
+
+        // start - binds and starts the I/O threads, throws if the address can't be bound
+        void start();
+        void stop();
+
+        net::io_context &context() {
+            return ioc;
+        }
+
+    private:
+        void do_accept();
+        void start_local();
+        void do_accept_local();
+
+        HttpServerOptions        options;
+        HttpHandler              handler;
+        net::io_context          ioc;
+        tcp::acceptor            acceptor;
+        std::vector<std::thread> threads;
+
+#ifndef _WIN32
+        std::optional<net::local::stream_protocol::acceptor> local_acceptor;
+#endif
+};
+
+// accepted_coding - the coding the request's Accept-Encoding asks for
+ContentCoding accepted_coding(const HttpRequest &request);
+
+// text_response - plain text reply that keeps the request's version and keep-alive, bodies past the threshold are compressed if accepted
+http::response<http::string_body> text_response(const HttpRequest &request, http::status status, std::string body);
+
+// json_response - body is already serialized JSON [JsonWriter], compressed like text_response
+http::response<http::string_body> json_response(const HttpRequest &request, http::status status, std::string body);
+
+// binary_response - application/octet-stream, never compressed or cached [telemetry frames]
+http::response<http::string_body> binary_response(const HttpRequest &request, http::status status, std::string body);
+
+// too_many_requests - 429 text reply, Retry-After rounded up to whole seconds
+http::response<http::string_body> too_many_requests(const HttpRequest &request, std::chrono::milliseconds retry_after);
+
+// stream_header - 200 header for an HttpChunkedWriter, pass accepted_coding(request) to the writer to compress the stream
+http::response<http::empty_body> stream_header(const HttpRequest &request, std::string_view content_type);
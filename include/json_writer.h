@@ -0,0 +1,127 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Streaming JSON writer, appends straight to a std::string [usually the response body] with no DOM in between.
+// Commas are placed automatically:
+//   json.begin_object(); json.key("players"); json.begin_array(); ... json.end_array(); json.end_object();
+class JsonWriter {
+    public:
+        explicit JsonWriter(std::string &in_out) : out(in_out) {}
+
+        void begin_object() {
+            separate();
+            out += '{';
+            push();
+        }
+
+        void end_object() {
+            pop();
+            out += '}';
+        }
+
+        void begin_array() {
+            separate();
+            out += '[';
+            push();
+        }
+
+        void end_array() {
+            pop();
+            out += ']';
+        }
+
+        void key(std::string_view name) {
+            separate();
+            write_string(name);
+            out += ':';
+            after_key = true;
+        }
+
+        void value(std::string_view text) {
+            separate();
+            write_string(text);
+        }
+
+        void value(const char *text) {
+            value(std::string_view(text));
+        }
+
+        void value(bool flag) {
+            separate();
+            out += flag ? "true" : "false";
+        }
+
+        template<typename NumberType, typename = std::enable_if_t<std::is_arithmetic_v<NumberType> && !std::is_same_v<NumberType, bool>>>
+        void value(NumberType number) {
+            separate();
+
+            char buffer[32];
+            auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+            out.append(buffer, end);
+        }
+
+        void null() {
+            separate();
+            out += "null";
+        }
+
+        // value_utf16 - UTF-16 text [FString data] written as UTF-8, a trailing terminator is dropped
+        void value_utf16(const wchar_t *text, size_t length);
+
+        // value_hex32 - "0123abcd", how UIDs are printed everywhere else
+        void value_hex32(uint32_t number);
+
+        // raw - pre-serialized JSON value
+        void raw(std::string_view json) {
+            separate();
+            out += json;
+        }
+
+        template<typename ValueType>
+        void field(std::string_view name, ValueType &&field_value) {
+            key(name);
+            value(std::forward<ValueType>(field_value));
+        }
+
+        std::string &buffer() {
+            return out;
+        }
+
+        // reset_separator - the next value starts a new sequence, used when a stream continues an array in a fresh buffer
+        void reset_separator(bool first_in_container) {
+            needs_comma = !first_in_container;
+        }
+
+    private:
+        void separate() {
+            if (after_key) {
+                after_key = false;
+                return;
+            }
+
+            if (needs_comma) {
+                out += ',';
+            }
+            needs_comma = true;
+        }
+
+        void push() {
+            needs_comma = false;
+        }
+
+        void pop() {
+            needs_comma = true;
+            after_key   = false;
+        }
+
+        void write_string(std::string_view text);
+
+        std::string &out;
+        bool         needs_comma = false;
+        bool         after_key   = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Settings from pal_loader.ini next to the server executable, "key = value" per line, "#" or ";" comments.
+// Missing keys keep the defaults below.
+struct LoaderConfig {
+        // HTTP API
+        std::string http_address = "127.0.0.1";
+        int         http_port    = 53000;
+        int         http_threads = 2;
+
+        // also serve the API to local tools without TCP, a named pipe ["\\.\pipe\pal_loader"] or a unix socket path, empty for none
+        std::string http_local_path;
+
+        // responses at least this long are gzip/deflate compressed for clients that accept it, level 1 [fast] .. 9 [small]
+        int http_compression_min_bytes = 1024;
+        int http_compression_level     = 4;
+
+        // Source RCON listener, on the HTTP server's threads; off while the password is empty
+        std::string rcon_address = "127.0.0.1";
+        int         rcon_port    = 25576;
+        std::string rcon_password;
+
+        // rate limits per client address, tokens per second and bucket size, 0 per second for none.
+        // Reads are served from the world snapshot, writes run on the game thread.
+        double admission_read_rate   = 50;
+        double admission_read_burst  = 100;
+        double admission_write_rate  = 5;
+        double admission_write_burst = 20;
+
+        // comma separated API tokens [Authorization header] limited on their own as well, by the same rates
+        std::vector<std::string> admission_tokens;
+
+        // game thread tasks the HTTP API and RCON may start per game_thread_window_ms, all clients together, 0 for no limit
+        double admission_game_thread_tasks = 8;
+
+        // game thread dispatcher, at most budget ms of queued commands per window ms
+        double game_thread_budget_ms = 2.0;
+        double game_thread_window_ms = 16.0;
+
+        // how often the game thread publishes the world snapshot read by the HTTP API
+        int snapshot_interval_ms = 250;
+};
+
+// loader_config - loaded on first use
+const LoaderConfig &loader_config();
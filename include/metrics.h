@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Latency histogram with fixed log-linear buckets: two per power of two [16, 24, 32, 48, 64, ... us] up to ~100 s.
+// record() is a relaxed increment and an add, safe from any thread and never blocks.
+class LatencyHistogram {
+    public:
+        static constexpr size_t num_buckets = 47; // the last one counts what is past every bound, it only shows in +Inf
+
+        void record(std::chrono::steady_clock::duration elapsed);
+
+        // bucket_bound_us - inclusive upper bound of bucket i in microseconds
+        static uint64_t bucket_bound_us(size_t index);
+
+        // write_prometheus - name_bucket{labels,le=...} lines, then _sum and _count
+        void write_prometheus(std::string &out, std::string_view name, std::string_view labels) const;
+
+    private:
+        std::array<std::atomic<uint64_t>, num_buckets> buckets {};
+        std::atomic<uint64_t>                          sum_ns = 0;
+};
+
+// Process wide counters and histograms of the HTTP API, RCON and the game thread dispatcher, served as Prometheus text [GET /metrics]
+namespace metrics {
+    extern std::atomic<int64_t>  http_connections;
+    extern std::atomic<uint64_t> http_bytes_sent;
+    extern std::atomic<uint64_t> http_read_errors;
+    extern std::atomic<uint64_t> http_write_errors;
+    extern std::atomic<uint64_t> http_handler_errors;
+    extern std::atomic<int64_t>  rcon_connections;
+    extern std::atomic<uint64_t> admission_rejected_reads;
+    extern std::atomic<uint64_t> admission_rejected_writes;
+
+    extern LatencyHistogram game_thread_queue_wait; // enqueue to start of run
+    extern LatencyHistogram game_thread_task_duration;
+    extern LatencyHistogram world_snapshot_capture;
+
+    // label - key="value" with the value escaped
+    std::string label(std::string_view key, std::string_view value);
+
+    // histogram - the series family{labels}, created on first call. Keep the reference, the lookup takes a lock.
+    LatencyHistogram &histogram(std::string_view family, std::string_view help, std::string_view labels);
+
+    // write_prometheus - everything in the text exposition format 0.0.4
+    void write_prometheus(std::string &out);
+} // namespace metrics
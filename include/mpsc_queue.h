@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+
+struct MpscNode {
+    std::atomic<MpscNode *> next { nullptr };
+};
+
+// Intrusive multi-producer single-consumer queue (Vyukov).
+// push() is wait-free and may be called from any thread, pop() and empty() only from the one consumer thread.
+class MpscQueue {
+    public:
+        MpscQueue() : head(&stub), tail(&stub) {}
+
+        MpscQueue(const MpscQueue &)            = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        void push(MpscNode *node) {
+            node->next.store(nullptr, std::memory_order_relaxed);
+
+            MpscNode *prev = head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        // pop - nullptr when empty, or when a producer is half way through push(), the node shows up on a later pop
+        MpscNode *pop() {
+            MpscNode *first = tail;
+            MpscNode *next  = first->next.load(std::memory_order_acquire);
+
+            if (first == &stub) {
+                if (!next) {
+                    return nullptr;
+                }
+
+                tail  = next;
+                first = next;
+                next  = next->next.load(std::memory_order_acquire);
+            }
+
+            if (next) {
+                tail = next;
+                return first;
+            }
+
+            if (first != head.load(std::memory_order_acquire)) {
+                return nullptr;
+            }
+
+            // first is the last node, put the stub behind it so it can be handed out
+            push(&stub);
+
+            next = first->next.load(std::memory_order_acquire);
+            if (next) {
+                tail = next;
+                return first;
+            }
+
+            return nullptr;
+        }
+
+        bool empty() const {
+            return tail == &stub && !stub.next.load(std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<MpscNode *> head;
+        MpscNode               *tail;
+        MpscNode                stub;
+};
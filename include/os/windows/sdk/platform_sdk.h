@@ -2,18 +2,28 @@
 
 #include <stdint.h>
 
+// Dumped offsets, ResolveOffsets() replaces them with the ones its signatures find in the running game.
 namespace Offsets {
-    constexpr int32_t GObjects                 = 0x088818E0;
-    constexpr int32_t GWorld                   = 0x089ED4A0;
-    constexpr int32_t AppendString             = 0x02D35860;
-    constexpr int32_t GNames                   = 0x00000000;
-    constexpr int32_t ProcessEvent             = 0x02EE14C0;
-    constexpr int32_t ProcessEventIdx          = 0x0000004C;
-    constexpr int32_t ForceGarbageCollection   = 0x04EF0AE0;
-    constexpr int32_t LowLevelGetRemoteAddress = 0x013CBA00;
-    constexpr int32_t KickPlayer               = 0x02B41240;
-    constexpr int32_t GetEmptyFText            = 0x02C3AF30;
-    constexpr int32_t SpawnPlayActor           = 0x04ADA840;
+    inline int32_t GObjects                 = 0x088818E0;
+    inline int32_t GWorld                   = 0x089ED4A0;
+    inline int32_t AppendString             = 0x02D35860;
+    inline int32_t GNames                   = 0x00000000;
+    inline int32_t ProcessEvent             = 0x02EE14C0;
+    inline int32_t ProcessEventIdx          = 0x0000004C;
+    inline int32_t ForceGarbageCollection   = 0x04EF0AE0;
+    inline int32_t LowLevelGetRemoteAddress = 0x013CBA00;
+    inline int32_t KickPlayer               = 0x02B41240;
+    inline int32_t GetEmptyFText            = 0x02C3AF30;
+    inline int32_t SpawnPlayActor           = 0x04ADA840;
+    inline int32_t MasterSerialNumber       = 0x00000000;
 } // namespace Offsets
 
-uintptr_t GetImageBaseOffset();
\ No newline at end of file
+uintptr_t GetImageBaseOffset();
+
+// GetGameThreadId - the engine's game thread, 0 if it can't be told. On Windows it is the process main thread [GuardedMain runs there].
+uint32_t GetGameThreadId();
+
+// ResolveOffsets - scans the game image for the Offsets signatures, or loads them from the cache of a previous run.
+// A function no signature found is set to 0 and its features stay off. Returns false if GObjects, GWorld or
+// AppendString weren't found, the SDK can't be used then.
+bool ResolveOffsets();
\ No newline at end of file
@@ -4,4 +4,7 @@
 #include <string>
 
 std::wstring local_codepage_to_utf16(std::string input);
-std::string utf16_to_local_codepage(wchar_t * data, size_t len);
\ No newline at end of file
+std::string utf16_to_local_codepage(wchar_t * data, size_t len);
+std::string utf16_to_utf8(const wchar_t *data, size_t len);
+std::wstring utf8_to_utf16(const std::string &utf8);
+std::string wide_to_narrow(const std::wstring &wide);
\ No newline at end of file
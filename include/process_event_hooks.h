@@ -0,0 +1,101 @@
+#pragma once
+
+#include "SDK.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Handlers for UObject::ProcessEvent calls of chosen UFunctions, for plugins that want game events [chat, damage,
+// capture, building] without a funchook per native function. They run on the game thread, inside the detour.
+//
+// The detour looks every call up in a flat open addressed table keyed by UFunction*. The table is kept at most
+// 1/16 full, so a function without handlers almost always costs one probe of an empty slot and a branch.
+// Registering builds a new table and publishes it. Only the game thread reads tables, so the old one is freed the
+// next time the game thread enters ProcessEvent from outside of it [quiescent()], no handler can run from it then.
+namespace process_event {
+    // PreHandler - runs before the engine, false skips the call, the remaining pre handlers and every post handler
+    using PreHandler  = std::function<bool(const SDK::UObject *object, void *params)>;
+    using PostHandler = std::function<void(const SDK::UObject *object, void *params)>;
+
+    using HandlerId = uint64_t;
+
+    struct Handlers {
+            std::vector<std::pair<HandlerId, PreHandler>>  pre;
+            std::vector<std::pair<HandlerId, PostHandler>> post;
+    };
+
+    // add_pre / add_post - safe from any thread, handlers of one function run in the order they were added. 0 for a null function.
+    HandlerId add_pre(const SDK::UFunction *function, PreHandler handler);
+    HandlerId add_post(const SDK::UFunction *function, PostHandler handler);
+
+    void remove(HandlerId id);
+
+    // before / after - the same with typed params: before<SDK::Params::APalPlayerState_EnterChat_Receive_Params>(...)
+    template<typename ParamsType, typename Fn>
+    HandlerId before(SDK::EFunctionId id, Fn &&fn) {
+        return add_pre(SDK::FFunctionTable::Get(id), [fn = std::forward<Fn>(fn)](const SDK::UObject *object, void *params) {
+            return fn(object, static_cast<ParamsType *>(params));
+        });
+    }
+
+    template<typename ParamsType, typename Fn>
+    HandlerId after(SDK::EFunctionId id, Fn &&fn) {
+        return add_post(SDK::FFunctionTable::Get(id), [fn = std::forward<Fn>(fn)](const SDK::UObject *object, void *params) {
+            fn(object, static_cast<ParamsType *>(params));
+        });
+    }
+
+    namespace detail {
+        struct Slot {
+                const SDK::UFunction *function;
+                const Handlers       *handlers;
+        };
+
+        struct Table {
+                const Slot *slots;
+                size_t      mask;
+                unsigned    shift; // 64 - log2(slots)
+        };
+
+        extern std::atomic<const Table *> current;
+        extern std::atomic<bool>          has_retired;
+
+        void free_retired();
+
+        // slot_index - Fibonacci hashing, the multiply spreads the aligned pointer bits over the top of the word
+        inline size_t slot_index(const SDK::UFunction *function, unsigned shift) {
+            return static_cast<size_t>((reinterpret_cast<uintptr_t>(function) * 0x9E3779B97F4A7C15ull) >> shift);
+        }
+    } // namespace detail
+
+    // find - handlers of function, nullptr for almost every call. Game thread only, they stay valid until quiescent().
+    inline const Handlers *find(const SDK::UFunction *function) {
+        const detail::Table *table = detail::current.load(std::memory_order_acquire);
+
+        for (size_t index = detail::slot_index(function, table->shift);; index = (index + 1) & table->mask) {
+            const detail::Slot &slot = table->slots[index];
+
+            if (slot.function == function) {
+                return slot.handlers;
+            }
+            if (!slot.function) {
+                return nullptr;
+            }
+        }
+    }
+
+    // quiescent - called by the detour on the game thread while it holds no Handlers of any table, frees the replaced ones
+    inline void quiescent() {
+        if (detail::has_retired.load(std::memory_order_acquire)) [[unlikely]] {
+            detail::free_retired();
+        }
+    }
+
+    // run_pre / run_post - the detour's slow path, run_pre returns false if a handler skipped the call
+    bool run_pre(const Handlers &handlers, const SDK::UObject *object, void *params);
+    void run_post(const Handlers &handlers, const SDK::UObject *object, void *params);
+} // namespace process_event
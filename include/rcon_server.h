@@ -0,0 +1,47 @@
+#pragma once
+
+#include "commands.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <boost/asio.hpp>
+
+namespace net = boost::asio;  // from <boost/asio.hpp>
+using tcp     = net::ip::tcp; // from <boost/asio/ip/tcp.hpp>
+
+struct RconServerOptions {
+        std::string    address = "127.0.0.1";
+        unsigned short port    = 25576; // the game's own RCON usually has 25575
+        std::string    password;
+        size_t         pipeline_limit = 16; // commands in flight per connection before reading pauses
+};
+
+// Source RCON protocol listener, for admin tools that already speak it [mcrcon, rcon-cli, ...].
+//
+// Runs on an io_context someone else drives [the HTTP server's], one strand per connection. Commands are the
+// console's [parse_command], they run on the game thread like HTTP's and their replies go out in request order,
+// split into packets of at most 4096 bytes. A client may pipeline commands; an empty SERVERDATA_RESPONSE_VALUE
+// is mirrored back after everything sent before it, which is how clients find the end of a multi-packet reply.
+// Commands are rate limited as writes [admission.h] by the client's address, together with its HTTP requests.
+class RconServer {
+    public:
+        RconServer(net::io_context &ioc, RconServerOptions options, std::shared_ptr<SDKContext> sdkContext);
+        ~RconServer();
+
+        RconServer(const RconServer &)            = delete;
+        RconServer &operator=(const RconServer &) = delete;
+
+        // start - binds and accepts, throws if the address can't be bound
+        void start();
+        void stop();
+
+    private:
+        void do_accept();
+
+        net::io_context                         &ioc;
+        std::shared_ptr<const RconServerOptions> options; // shared with the sessions
+        std::shared_ptr<SDKContext>              sdkContext;
+        tcp::acceptor                            acceptor;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "http_server.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// One pre-serialized body, immutable once stored. Compressed variants are made on first request and kept beside it.
+struct CachedResponse {
+        uint64_t                              version;
+        std::chrono::steady_clock::time_point created;
+        std::string                           body;
+        std::string                           content_type;
+        std::string                           etag; // strong over the body ["\"9f86d081884c7d65\""], weak over an ETag basis ["W/\"9f86d081884c7d65\""]
+
+        // encoded - the body in coding, compressed once per entry whichever thread asks first
+        const std::string &encoded(ContentCoding coding) const;
+
+        // encoded_etag - a representation has its own tag ["\"9f86d081884c7d65-gzip\""]
+        std::string encoded_etag(ContentCoding coding) const;
+
+    private:
+        static constexpr size_t num_codings = 3;
+
+        mutable std::array<std::once_flag, num_codings> encode_once;
+        mutable std::array<std::string, num_codings>    encoded_bodies;
+};
+
+// Response bodies keyed by route and path parameters and the version of the data they were rendered from [world snapshot sequence].
+// A hit is one hash lookup under a shared lock, the body goes out without a copy [HttpSharedBodyWriter].
+class ResponseCache {
+    public:
+        explicit ResponseCache(size_t in_max_entries = 1024) : max_entries(in_max_entries) {}
+
+        // find - the entry for key if it was rendered from version and is younger than ttl
+        std::shared_ptr<const CachedResponse> find(std::string_view key, uint64_t version, std::chrono::milliseconds ttl) const;
+
+        // store - replaces the entry for key, returns it for sending. The ETag is over etag_basis instead of the body if it
+        // isn't empty, for bodies with fields that change every version a client doesn't need to refetch for.
+        std::shared_ptr<const CachedResponse> store(std::string_view key, uint64_t version, std::string body, std::string_view content_type, std::string_view etag_basis = {});
+
+        void clear();
+
+    private:
+        struct KeyHash {
+                using is_transparent = void;
+
+                size_t operator()(std::string_view key) const {
+                    return std::hash<std::string_view> {}(key);
+                }
+        };
+
+        size_t                                                                                          max_entries;
+        mutable std::shared_mutex                                                                       lock;
+        std::unordered_map<std::string, std::shared_ptr<const CachedResponse>, KeyHash, std::equal_to<>> entries;
+};
+
+// cached_response_writer - 304 if the request's If-None-Match has the entry's ETag, otherwise the cached body,
+// compressed if it is past the threshold and the request accepts it
+std::unique_ptr<HttpResponseWriter> cached_response_writer(const HttpRequest &request, std::shared_ptr<const CachedResponse> entry);
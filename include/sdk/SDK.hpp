@@ -7,8 +7,26 @@
 // Main-package: Pal
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <type_traits>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <xmmintrin.h>
 
 typedef int8_t  int8;
 typedef int16_t int16;
@@ -934,3 +952,5 @@ static_assert(offsetof(SDK::FField, Owner) == 0x10, "FField::Owner has a wrong o
 static_assert(offsetof(SDK::FField, Next) == 0x20, "FField::Next has a wrong offset!");
 static_assert(offsetof(SDK::FField, Name) == 0x28, "FField::Name has a wrong offset!");
 static_assert(offsetof(SDK::FField, Flags) == 0x30, "FField::Flags has a wrong offset!");
+
+#include "SDK/FunctionTable.hpp"
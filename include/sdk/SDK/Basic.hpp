@@ -16,7 +16,10 @@ namespace SDK {
 
     struct FUObjectItem {
             class UObject *Object;
-            uint8          Pad_0[0x10];
+            int32          Flags;
+            int32          ClusterRootIndex;
+            int32          SerialNumber; // 0 until the engine first hands out a weak pointer to the object
+            uint8          Pad_0[0x4];
     };
 
     class TUObjectArray {
@@ -47,15 +50,131 @@ namespace SDK {
                 return reinterpret_cast<FUObjectItem **>(DecryptPtr(Objects));
             }
 
-            inline class UObject *GetByIndex(const int32 Index) const {
-                if (Index < 0 || Index > NumElements)
+            inline FUObjectItem *GetItemByIndex(const int32 Index) const {
+                if (Index < 0 || Index >= NumElements)
                     return nullptr;
 
                 const int32 ChunkIndex = Index / ElementsPerChunk;
                 const int32 InChunkIdx = Index % ElementsPerChunk;
 
-                return GetDecrytedObjPtr()[ChunkIndex][InChunkIdx].Object;
+                return &GetDecrytedObjPtr()[ChunkIndex][InChunkIdx];
+            }
+
+            inline class UObject *GetByIndex(const int32 Index) const {
+                FUObjectItem *Item = GetItemByIndex(Index);
+
+                return Item ? Item->Object : nullptr;
+            }
+
+            inline int32 NumChunksInUse() const {
+                return (NumElements + ElementsPerChunk - 1) / ElementsPerChunk;
+            }
+
+            // GetChunk - returns the items of one chunk and how many of them are in use
+            inline FUObjectItem *GetChunk(const int32 ChunkIndex, int32 &OutCount) const {
+                const int32 First = ChunkIndex * ElementsPerChunk;
+
+                OutCount = First < NumElements ? (NumElements - First < ElementsPerChunk ? NumElements - First : ElementsPerChunk) : 0;
+
+                return OutCount ? GetDecrytedObjPtr()[ChunkIndex] : nullptr;
+            }
+
+            // ForEachObject - calls Callback(UObject *) for every live object, walking the chunks directly.
+            // A callback returning bool stops the walk by returning false; returns false if it was stopped.
+            template<typename Fn>
+            inline bool ForEachObject(Fn &&Callback) const {
+                const int32 Chunks = NumChunksInUse();
+
+                for (int32 Chunk = 0; Chunk < Chunks; Chunk++) {
+                    if (!ForEachObjectInChunk(Chunk, Callback))
+                        return false;
+                }
+
+                return true;
+            }
+
+            // ForEachObjectOfClass - like ForEachObject, but only for objects that IsA(Class) [checked a chunk at a time]
+            template<typename Fn>
+            inline bool ForEachObjectOfClass(const class UClass *Class, Fn &&Callback) const;
+
+            // ParallelForEachObject - ForEachObject with the chunks spread across FParallelFor's workers.
+            // Callback runs concurrently and must be thread-safe, returning false from any thread stops all of them.
+            template<typename Fn>
+            inline bool ParallelForEachObject(Fn &&Callback) const;
+
+            template<typename Fn>
+            inline bool ParallelForEachObjectOfClass(const class UClass *Class, Fn &&Callback) const;
+
+        private:
+            enum {
+                PrefetchDistance = 8,
+            };
+
+            template<typename Fn>
+            static inline bool Invoke(Fn &Callback, class UObject *Object) {
+                if constexpr (std::is_same_v<decltype(Callback(Object)), bool>) {
+                    return Callback(Object);
+                } else {
+                    Callback(Object);
+                    return true;
+                }
             }
+
+            template<typename Fn>
+            inline bool ForEachObjectInChunk(const int32 ChunkIndex, Fn &Callback, const std::atomic<bool> *bStop = nullptr) const {
+                int32         Count = 0;
+                FUObjectItem *Items = GetChunk(ChunkIndex, Count);
+
+                for (int32 i = 0; i < Count; i++) {
+                    // the item array is read sequentially, the objects it points to are not
+                    if (i + PrefetchDistance < Count && Items[i + PrefetchDistance].Object)
+                        _mm_prefetch(reinterpret_cast<const char *>(Items[i + PrefetchDistance].Object), _MM_HINT_T0);
+
+                    if (bStop && bStop->load(std::memory_order_relaxed))
+                        return false;
+
+                    if (Items[i].Object && !Invoke(Callback, Items[i].Object))
+                        return false;
+                }
+
+                return true;
+            }
+    };
+
+    // Small persistent worker pool for sweeps over GObjects, the calling thread takes part in the work.
+    // Runs are serialized, so a sweep never competes with another one for the workers.
+    class FParallelFor {
+        public:
+            // Run - calls Task(0 .. NumTasks - 1) across the workers and returns when all of them finished.
+            // A task that throws stops the tasks not started yet, Run rethrows the first exception.
+            // Run from inside a task runs its tasks serially on that thread, the workers are busy with the outer one.
+            static void Run(int32 NumTasks, const std::function<void(int32)> &Task);
+
+            static int32 NumWorkers();
+
+        private:
+            struct FJob {
+                    const std::function<void(int32)> *Task;
+                    int32                             NumTasks;
+                    std::atomic<int32>                NextTask  = 0;
+                    int32                             NumActive = 0; // guarded by Lock
+                    std::exception_ptr                Error;         // the first task that threw, guarded by Lock
+            };
+
+            static void StartWorkers();
+            static void WorkerLoop();
+            static void Work(FJob &Job);
+
+            static inline std::mutex               RunLock;
+            static inline std::mutex               Lock;
+            static inline std::condition_variable  WakeUp;
+            static inline std::condition_variable  Finished;
+            static inline FJob                    *CurrentJob = nullptr;
+            static inline uint64                   Generation = 0;
+            static inline std::once_flag           WorkersStarted;
+            static inline std::vector<std::thread> Workers;
+
+            static inline thread_local int32 WorkDepth = 0; // tasks of a Run this thread is inside
     };
 
     template<class T>
@@ -142,6 +261,73 @@ namespace SDK {
             }
     };
 
+    // Intern cache of decoded name entries keyed by FName::ComparisonIndex.
+    // Each entry is decoded through AppendString once, stored as UTF-8 and never freed, so the views stay valid.
+    class FNameCache {
+        public:
+            // GetEntry - returns the raw entry without the number suffix ["/Script/CoreUObject", "PalPlayerCharacter"]
+            static std::string_view GetEntry(int32 ComparisonIndex);
+
+            // FindComparisonIndex - reverse lookup of a raw entry, only knows entries that were decoded before
+            static bool FindComparisonIndex(std::string_view Entry, int32 &OutComparisonIndex);
+
+            static int32 Num();
+
+        private:
+            enum {
+                NumShards = 64,
+            };
+
+            struct FShard {
+                    std::shared_mutex                          Lock;
+                    std::unordered_map<int32, std::string_view> Entries;
+                    std::unordered_map<std::string_view, int32> Indices;
+                    std::vector<std::unique_ptr<char[]>>       Storage;
+            };
+
+            static std::string Decode(int32 ComparisonIndex);
+
+            static inline FShard &GetShard(uint32 Hash) {
+                return Shards[(Hash * 0x9E3779B1u) >> 26];
+            }
+
+            static inline FShard Shards[NumShards];
+    };
+
+    // Fixed-capacity buffer for building object paths on the stack, silently truncates at Capacity.
+    // Named append() so it can be used wherever a std::string or fmt::memory_buffer is accepted.
+    template<size_t Capacity = 512>
+    class TFixedPathBuffer {
+        public:
+            inline void append(const char *Begin, const char *End) {
+                const size_t Length = static_cast<size_t>(End - Begin);
+                const size_t Fit    = Length < Capacity - Size ? Length : Capacity - Size;
+
+                std::memcpy(Data + Size, Begin, Fit);
+
+                Size += Fit;
+                bTruncated |= Fit < Length;
+            }
+
+            inline std::string_view View() const {
+                return std::string_view(Data, Size);
+            }
+
+            inline bool IsTruncated() const {
+                return bTruncated;
+            }
+
+            inline void Reset() {
+                Size       = 0;
+                bTruncated = false;
+            }
+
+        private:
+            char   Data[Capacity];
+            size_t Size       = 0;
+            bool   bTruncated = false;
+    };
+
     class FName {
         public:
             // GNames - either of type TNameEntryArray [<4.23] or FNamePool [>=4.23]
@@ -156,18 +342,48 @@ namespace SDK {
                 return ComparisonIndex;
             }
 
-            // GetRawString - returns an unedited string as the engine uses it
-            inline std::string GetRawString() const {
-                thread_local FString TempString(1024);
-                static void (*AppendString)(const FName *, FString &) = nullptr;
+            // GetEntryView - returns the cached, unedited entry without the number suffix
+            inline std::string_view GetEntryView() const {
+                return FNameCache::GetEntry(GetDisplayIndex());
+            }
+
+            // GetPlainNameView - returns the cached entry edited like ToString() but without the number suffix
+            inline std::string_view GetPlainNameView() const {
+                std::string_view Entry = GetEntryView();
+
+                size_t pos = Entry.rfind('/');
+
+                if (pos == std::string_view::npos)
+                    return Entry;
+
+                return Entry.substr(pos + 1);
+            }
+
+            // AppendNumber - appends the "_N" suffix the engine adds for numbered names
+            template<typename BufferType>
+            inline void AppendNumber(BufferType &Out) const {
+                if (Number <= 0)
+                    return;
+
+                char Buffer[16] = { '_' };
+                auto Result     = std::to_chars(Buffer + 1, Buffer + sizeof(Buffer), Number - 1);
 
-                if (!AppendString)
-                    AppendString = reinterpret_cast<void (*)(const FName *, FString &)>(uintptr_t(GetImageBaseOffset()) + Offsets::AppendString);
+                Out.append(Buffer, Result.ptr);
+            }
+
+            // AppendTo - appends ToString() to a std::string, fmt::memory_buffer or TFixedPathBuffer without a temporary
+            template<typename BufferType>
+            inline void AppendTo(BufferType &Out) const {
+                std::string_view Plain = GetPlainNameView();
 
-                AppendString(this, TempString);
+                Out.append(Plain.data(), Plain.data() + Plain.size());
+                AppendNumber(Out);
+            }
 
-                std::string OutputString = TempString.ToString();
-                TempString.ResetNum();
+            // GetRawString - returns an unedited string as the engine uses it
+            inline std::string GetRawString() const {
+                std::string OutputString(GetEntryView());
+                AppendNumber(OutputString);
 
                 return OutputString;
             }
@@ -178,14 +394,26 @@ namespace SDK {
 
             // ToString - returns an edited string as it's used by most SDKs ["/Script/CoreUObject" -> "CoreUObject"]
             inline std::string ToString() const {
-                std::string OutputString = GetRawString();
+                std::string OutputString(GetPlainNameView());
+                AppendNumber(OutputString);
+
+                return OutputString;
+            }
+
+            // Equals - compares against an edited string [ToString() == Name] without building it
+            inline bool Equals(std::string_view Name) const {
+                std::string_view Plain = GetPlainNameView();
+
+                if (Number <= 0)
+                    return Name == Plain;
 
-                size_t pos = OutputString.rfind('/');
+                if (Name.size() <= Plain.size() + 1 || !Name.starts_with(Plain) || Name[Plain.size()] != '_')
+                    return false;
 
-                if (pos == std::string::npos)
-                    return OutputString;
+                char Buffer[16];
+                auto Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Number - 1);
 
-                return OutputString.substr(pos + 1);
+                return Name.substr(Plain.size() + 1) == std::string_view(Buffer, Result.ptr - Buffer);
             }
 
             inline bool operator==(const FName &Other) const {
@@ -284,26 +512,315 @@ namespace SDK {
             }
     };
 
+    // GetTypeHash - mirrors UE 5.1 TypeHash.h, TSet/TMap::Find() only works if the key lands in the bucket the engine used.
+    // Add an overload next to the key type for structs, TSet::IsHashCompatible() tells whether it matches the engine.
+    inline uint32 GetTypeHash(const int8 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const uint8 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const int16 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const uint16 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const int32 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const uint32 Value) {
+        return Value;
+    }
+
+    inline uint32 GetTypeHash(const uint64 Value) {
+        return static_cast<uint32>(Value) + (static_cast<uint32>(Value >> 32) * 23);
+    }
+
+    inline uint32 GetTypeHash(const int64 Value) {
+        return GetTypeHash(static_cast<uint64>(Value));
+    }
+
+    template<typename EnumType, typename = std::enable_if_t<std::is_enum_v<EnumType>>>
+    inline uint32 GetTypeHash(const EnumType Value) {
+        return GetTypeHash(static_cast<std::underlying_type_t<EnumType>>(Value));
+    }
+
+    // PointerHash - the low 4 bits are dropped, they're zero for any allocation
+    template<typename T>
+    inline uint32 GetTypeHash(T *const Value) {
+        return GetTypeHash(static_cast<uint64>(reinterpret_cast<uintptr_t>(Value) >> 4));
+    }
+
+    inline uint32 GetTypeHash(const FName &Name) {
+        return GetTypeHash(static_cast<uint32>(Name.ComparisonIndex)) + Name.Number;
+    }
+
+    // FCrc::MemCrc_DEPRECATED over the 16 bytes of the guid
+    uint32 GetTypeHash(const struct FGuid &Guid);
+
+    // Layout of TBitArray<FDefaultBitArrayAllocator> [TInlineAllocator<4>]
+    class FBitArray {
+        public:
+            uint32  InlineData[4];
+            uint32 *SecondaryData;
+            int32   NumBits;
+            int32   MaxBits;
+
+            inline bool operator[](int32 Index) const {
+                const uint32 *Words = SecondaryData ? SecondaryData : InlineData;
+
+                return (Words[Index / 32] >> (Index % 32)) & 1;
+            }
+    };
+
+    // Layout of TSparseArray, a TArray with holes tracked by AllocationFlags
+    template<typename ElementType>
+    class TSparseArray {
+        public:
+            // TSparseArrayElementOrFreeListLink - free slots hold two int32 links instead of an element
+            struct alignas(alignof(ElementType) > 4 ? alignof(ElementType) : 4) FElementOrFreeListLink {
+                    uint8 Storage[sizeof(ElementType) > 8 ? sizeof(ElementType) : 8];
+            };
+
+            TArray<FElementOrFreeListLink> Data;
+            FBitArray                      AllocationFlags;
+            int32                          FirstFreeIndex;
+            int32                          NumFreeIndices;
+
+        public:
+            inline int32 Num() const {
+                return Data.NumElements - NumFreeIndices;
+            }
+
+            // GetMaxIndex - one past the highest slot, allocated or not
+            inline int32 GetMaxIndex() const {
+                return Data.NumElements;
+            }
+
+            inline bool IsAllocated(int32 Index) const {
+                return Index >= 0 && Index < Data.NumElements && AllocationFlags[Index];
+            }
+
+            inline ElementType &operator[](int32 Index) {
+                return *reinterpret_cast<ElementType *>(Data.Data[Index].Storage);
+            }
+
+            inline const ElementType &operator[](int32 Index) const {
+                return *reinterpret_cast<const ElementType *>(Data.Data[Index].Storage);
+            }
+    };
+
+    template<typename ElementType>
+    class TSetElement {
+        public:
+            ElementType Value;
+            int32       HashNextId;
+            int32       HashIndex; // bucket the engine put the element in
+    };
+
+    // Read-only view of TSet: iteration over the sparse array and Find() through the engine's own hash buckets.
+    // Never add or remove elements through it, the engine owns the allocations.
     template<typename ElementType>
     class TSet {
-            uint8 WaitTillIImplementIt[0x50];
+        public:
+            using ElementStorage = TSetElement<ElementType>;
+
+            TSparseArray<ElementStorage> Elements;
+            int32                        InlineHash[1];
+            int32                       *SecondaryHash;
+            int32                        HashSize;
+
+        public:
+            template<typename SetType, typename ValueType>
+            class TIterator {
+                public:
+                    inline TIterator(SetType *InSet, int32 InIndex)
+                        : Set(InSet), Index(InIndex) {
+                        SkipFree();
+                    }
+
+                    inline ValueType &operator*() const {
+                        return Set->Elements[Index].Value;
+                    }
+
+                    inline ValueType *operator->() const {
+                        return &Set->Elements[Index].Value;
+                    }
+
+                    inline TIterator &operator++() {
+                        Index++;
+                        SkipFree();
+
+                        return *this;
+                    }
+
+                    inline bool operator!=(const TIterator &Other) const {
+                        return Index != Other.Index;
+                    }
+
+                private:
+                    inline void SkipFree() {
+                        while (Index < Set->Elements.GetMaxIndex() && !Set->Elements.IsAllocated(Index))
+                            Index++;
+                    }
+
+                    SetType *Set;
+                    int32    Index;
+            };
+
+            using FIterator      = TIterator<TSet, ElementType>;
+            using FConstIterator = TIterator<const TSet, const ElementType>;
+
+            inline FIterator begin() {
+                return FIterator(this, 0);
+            }
+
+            inline FIterator end() {
+                return FIterator(this, Elements.GetMaxIndex());
+            }
+
+            inline FConstIterator begin() const {
+                return FConstIterator(this, 0);
+            }
+
+            inline FConstIterator end() const {
+                return FConstIterator(this, Elements.GetMaxIndex());
+            }
+
+            inline int32 Num() const {
+                return Elements.Num();
+            }
+
+            inline ElementType *Find(const ElementType &Key) {
+                return FindByHash(GetTypeHash(Key), [&Key](const ElementType &Element) { return KeysEqual(Element, Key); });
+            }
+
+            inline const ElementType *Find(const ElementType &Key) const {
+                return const_cast<TSet *>(this)->Find(Key);
+            }
+
+            inline bool Contains(const ElementType &Key) const {
+                return Find(Key) != nullptr;
+            }
+
+            // FindByHash - walks the bucket of KeyHash, for keys that are not the element type (TMap)
+            template<typename Predicate>
+            inline ElementType *FindByHash(uint32 KeyHash, Predicate &&Matches) {
+                if (HashSize <= 0)
+                    return nullptr;
+
+                const int32 *Buckets = SecondaryHash ? SecondaryHash : InlineHash;
+
+                for (int32 Id = Buckets[KeyHash & (HashSize - 1)]; Id >= 0; Id = Elements[Id].HashNextId) {
+                    if (Matches(Elements[Id].Value))
+                        return &Elements[Id].Value;
+                }
+
+                return nullptr;
+            }
+
+            // FindLinear - for keys without a matching GetTypeHash, O(n)
+            template<typename Predicate>
+            inline ElementType *FindLinear(Predicate &&Matches) {
+                for (ElementType &Element : *this) {
+                    if (Matches(Element))
+                        return &Element;
+                }
+
+                return nullptr;
+            }
+
+            // IsHashCompatible - checks GetTypeHash against the buckets the engine stored for up to MaxChecks elements
+            template<typename KeyOf>
+            inline bool IsHashCompatible(KeyOf &&GetKey, int32 MaxChecks = 16) const {
+                int32 Checked = 0;
+
+                for (int32 i = 0; i < Elements.GetMaxIndex() && Checked < MaxChecks; i++) {
+                    if (!Elements.IsAllocated(i))
+                        continue;
+
+                    if (static_cast<int32>(GetTypeHash(GetKey(Elements[i].Value)) & (HashSize - 1)) != Elements[i].HashIndex)
+                        return false;
+
+                    Checked++;
+                }
+
+                return true;
+            }
+
+            inline bool IsHashCompatible(int32 MaxChecks = 16) const {
+                return IsHashCompatible([](const ElementType &Element) -> const ElementType & { return Element; }, MaxChecks);
+            }
+
+        protected:
+            template<typename KeyType>
+            static inline bool KeysEqual(const KeyType &Left, const KeyType &Right) {
+                if constexpr (requires { Left == Right; })
+                    return Left == Right;
+                else
+                    return std::memcmp(&Left, &Right, sizeof(KeyType)) == 0;
+            }
     };
 
+    // Read-only view of TMap, iterates TPair<Key, Value> [First = Key, Second = Value]
     template<typename KeyType, typename ValueType>
-    class TMap {
-            uint8 WaitTillIImplementIt[0x50];
+    class TMap : public TSet<TPair<KeyType, ValueType>> {
+        public:
+            using Super = TSet<TPair<KeyType, ValueType>>;
+
+            inline ValueType *Find(const KeyType &Key) {
+                auto *Pair = Super::FindByHash(GetTypeHash(Key), [&Key](const TPair<KeyType, ValueType> &Element) { return Super::KeysEqual(Element.First, Key); });
+
+                return Pair ? &Pair->Second : nullptr;
+            }
+
+            inline const ValueType *Find(const KeyType &Key) const {
+                return const_cast<TMap *>(this)->Find(Key);
+            }
+
+            inline bool Contains(const KeyType &Key) const {
+                return Find(Key) != nullptr;
+            }
+
+            inline bool IsHashCompatible(int32 MaxChecks = 16) const {
+                return Super::IsHashCompatible([](const TPair<KeyType, ValueType> &Element) -> const KeyType & { return Element.First; }, MaxChecks);
+            }
     };
 
+    // the views are read in place inside engine objects, the dumped member offsets depend on these sizes
+    static_assert(sizeof(FBitArray) == 0x20, "FBitArray has a wrong size!");
+    static_assert(sizeof(TSparseArray<int32>) == 0x38, "TSparseArray has a wrong size!");
+    static_assert(sizeof(TSet<int32>) == 0x50, "TSet has a wrong size!");
+    static_assert(sizeof(TMap<int32, int32>) == 0x50, "TMap has a wrong size!");
+
+    // Index + serial number handle, Get() returns nullptr once the object is gone, even if its slot was reused
     class FWeakObjectPtr {
         protected:
             int32 ObjectIndex;
             int32 ObjectSerialNumber;
 
         public:
+            // FromObject - handle to Object, assigning it a serial number the way the engine does if it never had one.
+            // Null for a dead object, or when ResolveOffsets didn't find the engine's serial counter [logged at startup].
+            static FWeakObjectPtr FromObject(const class UObject *Object);
+
+            // ResolveBatch - Get() for Count handles at once, stale ones resolve to nullptr. Returns how many are still alive.
+            static int32 ResolveBatch(const FWeakObjectPtr *Ptrs, int32 Count, class UObject **OutObjects);
+
             class UObject *Get() const;
 
             class UObject *operator->() const;
 
+            inline bool IsValid() const {
+                return Get() != nullptr;
+            }
+
             bool operator==(const FWeakObjectPtr &Other) const;
             bool operator!=(const FWeakObjectPtr &Other) const;
 
@@ -314,6 +831,21 @@ namespace SDK {
     template<typename UEType>
     class TWeakObjectPtr : FWeakObjectPtr {
         public:
+            static TWeakObjectPtr FromObject(const UEType *Object) {
+                TWeakObjectPtr Ptr;
+                static_cast<FWeakObjectPtr &>(Ptr) = FWeakObjectPtr::FromObject(Object);
+
+                return Ptr;
+            }
+
+            static int32 ResolveBatch(const TWeakObjectPtr *Ptrs, int32 Count, UEType **OutObjects) {
+                static_assert(sizeof(TWeakObjectPtr) == sizeof(FWeakObjectPtr));
+
+                return FWeakObjectPtr::ResolveBatch(Ptrs, Count, reinterpret_cast<class UObject **>(OutObjects));
+            }
+
+            using FWeakObjectPtr::IsValid;
+
             UEType *Get() const {
                 return static_cast<UEType *>(FWeakObjectPtr::Get());
             }
@@ -321,6 +853,13 @@ namespace SDK {
             UEType *operator->() const {
                 return static_cast<UEType *>(FWeakObjectPtr::Get());
             }
+
+            bool operator==(const TWeakObjectPtr &Other) const {
+                return FWeakObjectPtr::operator==(Other);
+            }
+            bool operator!=(const TWeakObjectPtr &Other) const {
+                return FWeakObjectPtr::operator!=(Other);
+            }
     };
 
     struct FUniqueObjectGuid {
@@ -518,6 +1057,174 @@ namespace SDK {
         return ((static_cast<ClassFlagsType>(Left) & static_cast<ClassFlagsType>(Right)) == static_cast<ClassFlagsType>(Right));
     }
 
+    // Name-keyed index over GObjects, used by UObject::FindObject/FindObjectFast/FindClassFast.
+    // Every FName is decoded once while indexing; lookups hash the query and never allocate.
+    // Slots freed or reused by GC are detected on lookup and re-indexed on demand.
+    class FObjectNameIndex {
+        public:
+            // Indexes every live object. Called lazily on first lookup, call it after InitGObjects() to pay the cost upfront.
+            static void Build();
+
+            // Re-indexes slots that were appended, reused or renamed since the last Build/Sync.
+            // Finding them is a compare per slot under the shared lock, only changed slots are decoded under the exclusive one.
+            static void Sync();
+
+            // First (lowest index) live object named Name ["Actor", "Default__PalUtility"] matching RequiredType
+            static class UObject *FindByName(std::string_view Name, EClassCastFlags RequiredType);
+
+            // First live object whose GetFullName() equals FullName ["Class Engine.Actor"] matching RequiredType
+            static class UObject *FindByFullName(std::string_view FullName, EClassCastFlags RequiredType);
+
+            static int32 NumIndexed();
+
+        private:
+            struct FStringHash {
+                    using is_transparent = void;
+
+                    inline size_t operator()(std::string_view Str) const {
+                        return std::hash<std::string_view> {}(Str);
+                    }
+            };
+
+            using FBucket = std::vector<int32>;
+
+            static class UObject *Find(std::string_view Name, std::string_view FullName, EClassCastFlags RequiredType);
+            static class UObject *FindLocked(std::string_view Name, std::string_view FullName, EClassCastFlags RequiredType);
+            static void           IndexSlot(int32 Index, class UObject *Object);
+            static void           UnindexSlot(int32 Index);
+            static bool           SlotChanged(int32 Index, class UObject *Object);
+
+            static inline std::shared_mutex                                                     Lock;
+            static inline std::atomic<bool>                                                     bBuilt = false;
+            static inline std::unordered_map<std::string, FBucket, FStringHash, std::equal_to<>> Buckets;
+            static inline std::unordered_map<uint64, FBucket *>                                 BucketsByName; // (ComparisonIndex, Number) -> bucket
+            static inline std::vector<class UObject *>                                          Slots;         // object seen at each index when it was indexed
+            static inline std::vector<FBucket *>                                                SlotBuckets;
+            static inline std::vector<uint64>                                                   SlotNames;     // (ComparisonIndex, Number) of each slot when it was indexed
+    };
+
+    // Per thread scratch for the *OfClass iterations, one buffer per nesting level so a callback can iterate again.
+    class FMatchBuffer {
+        public:
+            inline FMatchBuffer() : Matches(Acquire()) {}
+
+            inline ~FMatchBuffer() {
+                Depth--;
+            }
+
+            FMatchBuffer(const FMatchBuffer &)            = delete;
+            FMatchBuffer &operator=(const FMatchBuffer &) = delete;
+
+            std::vector<class UObject *> &Matches;
+
+        private:
+            // a deque, growing it for a nested level leaves the outer levels' buffers where they are
+            static inline std::vector<class UObject *> &Acquire() {
+                if (Buffers.size() <= static_cast<size_t>(Depth))
+                    Buffers.emplace_back();
+
+                return Buffers[Depth++];
+            }
+
+            static inline thread_local std::deque<std::vector<class UObject *>> Buffers;
+            static inline thread_local int32                                    Depth = 0;
+    };
+
+    // Class tree numbered by an Euler tour over every UClass in GObjects.
+    // A class is a child of Base exactly when its Enter lies in [Base.Enter, Base.Exit), so IsA becomes a range check.
+    // Classes created after Build() are unknown to the table and callers fall back to walking UStruct::Super.
+    class FClassHierarchy {
+        public:
+            struct FNode {
+                    const class UClass *Class = nullptr;
+                    int32               Enter = -1;
+                    int32               Exit  = -1;
+                    int32               Depth = -1;
+            };
+
+            static void Build();
+
+            // TryIsChildOf - returns false if either class is unknown, otherwise stores Class->IsChildOf(Base) in bOutResult
+            static bool TryIsChildOf(const class UClass *Class, const class UClass *Base, bool &bOutResult);
+
+            // FilterByClass - writes every live object in Items[0, Count) that IsA(Base) to OutObjects, returns how many were written
+            static int32 FilterByClass(const FUObjectItem *Items, int32 Count, const class UClass *Base, class UObject **OutObjects);
+
+            static int32 NumClasses();
+
+        private:
+            struct FTable {
+                    std::vector<FNode> Nodes; // indexed by UObject::Index of the class
+                    int32              NumClasses = 0;
+            };
+
+            static const FNode *FindNode(const FTable *Table, const class UClass *Class);
+
+            static inline std::atomic<const FTable *>         Current = nullptr;
+            static inline std::mutex                          BuildLock;
+            static inline std::vector<std::unique_ptr<FTable>> Tables; // never freed, readers may still hold an old table
+    };
+
+    template<typename Fn>
+    inline bool TUObjectArray::ForEachObjectOfClass(const class UClass *Class, Fn &&Callback) const {
+        FMatchBuffer Buffer;
+        auto        &Matches = Buffer.Matches;
+
+        const int32 Chunks = NumChunksInUse();
+
+        for (int32 Chunk = 0; Chunk < Chunks; Chunk++) {
+            int32         Count = 0;
+            FUObjectItem *Items = GetChunk(Chunk, Count);
+
+            Matches.resize(Count);
+
+            const int32 NumMatches = FClassHierarchy::FilterByClass(Items, Count, Class, Matches.data());
+
+            for (int32 i = 0; i < NumMatches; i++) {
+                if (!Invoke(Callback, Matches[i]))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename Fn>
+    inline bool TUObjectArray::ParallelForEachObject(Fn &&Callback) const {
+        std::atomic<bool> bStop = false;
+
+        FParallelFor::Run(NumChunksInUse(), [&](int32 Chunk) {
+            if (!bStop.load(std::memory_order_relaxed) && !ForEachObjectInChunk(Chunk, Callback, &bStop))
+                bStop.store(true, std::memory_order_relaxed);
+        });
+
+        return !bStop;
+    }
+
+    template<typename Fn>
+    inline bool TUObjectArray::ParallelForEachObjectOfClass(const class UClass *Class, Fn &&Callback) const {
+        std::atomic<bool> bStop = false;
+
+        FParallelFor::Run(NumChunksInUse(), [&](int32 Chunk) {
+            FMatchBuffer Buffer;
+            auto        &Matches = Buffer.Matches;
+
+            int32         Count = 0;
+            FUObjectItem *Items = GetChunk(Chunk, Count);
+
+            Matches.resize(Count);
+
+            const int32 NumMatches = FClassHierarchy::FilterByClass(Items, Count, Class, Matches.data());
+
+            for (int32 i = 0; i < NumMatches && !bStop.load(std::memory_order_relaxed); i++) {
+                if (!Invoke(Callback, Matches[i]))
+                    bStop.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        return !bStop;
+    }
+
     class FScriptInterface {
         public:
             UObject *ObjectPointer    = nullptr;
@@ -708,4 +1415,90 @@ namespace SDK {
     #pragma pack(pop)
 #endif
 
+    // Property name -> offset tables built from UStruct::ChildProperties, one per struct on first use.
+    // Offsets come from the running game, so they stay correct when a patch moves fields around.
+    class FPropertyOffsets {
+        public:
+            struct FPropertyInfo {
+                    int32 Offset      = -1;
+                    int32 ElementSize = 0;
+            };
+
+            // Find - property named PropertyName declared on Struct or one of its supers, Offset is -1 if there is none
+            static FPropertyInfo Find(const class UStruct *Struct, std::string_view PropertyName);
+
+        private:
+            struct FStringHash {
+                    using is_transparent = void;
+
+                    inline size_t operator()(std::string_view Str) const {
+                        return std::hash<std::string_view> {}(Str);
+                    }
+            };
+
+            using FTable = std::unordered_map<std::string, FPropertyInfo, FStringHash, std::equal_to<>>;
+
+            static const FTable &GetTable(const class UStruct *Struct);
+
+            static inline std::shared_mutex                                Lock;
+            static inline std::unordered_map<const class UStruct *, FTable> Tables;
+    };
+
+    // Base of every TRuntimeField, registers itself so FRuntimeFields::Resolve() can find it.
+    class FRuntimeField {
+        public:
+            inline FRuntimeField(const char *InStructName, const char *InFieldName, int32 InFallbackOffset, int32 InSize)
+                : StructName(InStructName), FieldName(InFieldName), Offset(InFallbackOffset), Size(InSize), Next(First) {
+                First = this;
+            }
+
+            FRuntimeField(const FRuntimeField &)            = delete;
+            FRuntimeField &operator=(const FRuntimeField &) = delete;
+
+            inline int32 GetOffset() const {
+                return Offset;
+            }
+
+        protected:
+            friend class FRuntimeFields;
+
+            const char    *StructName; // reflected name, without the C++ prefix ["PalGameStateInGame"]
+            const char    *FieldName;
+            int32          Offset; // Dumper-7 offset until resolved
+            int32          Size;
+            FRuntimeField *Next;
+
+            static inline FRuntimeField *First = nullptr;
+    };
+
+    // Opt-in accessor for a field whose offset is resolved through reflection at startup instead of baked in.
+    // Once resolved, a read is one load of the offset plus the access itself.
+    template<typename OwnerType, typename FieldType>
+    class TRuntimeField : public FRuntimeField {
+        public:
+            using FRuntimeField::FRuntimeField;
+
+            inline FieldType &Get(OwnerType *Object) const {
+                return *reinterpret_cast<FieldType *>(reinterpret_cast<uint8 *>(Object) + Offset);
+            }
+
+            inline const FieldType &Get(const OwnerType *Object) const {
+                return *reinterpret_cast<const FieldType *>(reinterpret_cast<const uint8 *>(Object) + Offset);
+            }
+    };
+
+    class FRuntimeFields {
+        public:
+            // Resolve - resolves every TRuntimeField, returns false if one is missing or changed size ["PalGameStateInGame.ServerFrameTime"].
+            // Fields that fail keep their Dumper-7 offset, which must not be read: the caller stops when this returns false.
+            static bool Resolve(std::vector<std::string> *OutFailed = nullptr);
+    };
+
+// SDK_RUNTIME_FIELD(APalGameStateInGame, ServerFrameTime) declares APalGameStateInGame_ServerFrameTime, falling back to the generated offset.
+// The reflected struct name is the C++ name without its A/U/F prefix.
+#define SDK_RUNTIME_FIELD(OwnerType, Field)                                                                                                     \
+    inline SDK::TRuntimeField<SDK::OwnerType, decltype(SDK::OwnerType::Field)> OwnerType##_##Field {                                            \
+        &#OwnerType[1], #Field, static_cast<int32>(offsetof(SDK::OwnerType, Field)), static_cast<int32>(sizeof(decltype(SDK::OwnerType::Field))) \
+    }
+
 } // namespace SDK
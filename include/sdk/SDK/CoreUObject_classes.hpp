@@ -35,43 +35,24 @@ public:
 
 	std::string GetFullName() const;
 
+	// AppendFullName - appends GetFullName() to a std::string, fmt::memory_buffer or TFixedPathBuffer, outers are written outermost first
+	template<typename BufferType>
+	void AppendFullName(BufferType& Buffer) const;
+
+	// IsFullName - GetFullName() == FullName without building it, compares segment by segment starting at the object's own name
+	bool IsFullName(std::string_view FullName) const;
+
 	template<typename UEType = UObject>
 	static UEType* FindObject(const std::string& FullName, EClassCastFlags RequiredType = EClassCastFlags::None)
 	{
-		for (int i = 0; i < GObjects->Num(); ++i)
-		{
-			UObject* Object = GObjects->GetByIndex(i);
-	
-			if (!Object)
-				continue;
-			
-			if (Object->HasTypeFlag(RequiredType) && Object->GetFullName() == FullName)
-			{
-				return static_cast<UEType*>(Object);
-			}
-		}
-
-		return nullptr;
+		return static_cast<UEType*>(FObjectNameIndex::FindByFullName(FullName, RequiredType));
 	}
 
 
 	template<typename UEType = UObject>
 	static UEType* FindObjectFast(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)
 	{
-		for (int i = 0; i < GObjects->Num(); ++i)
-		{
-			UObject* Object = GObjects->GetByIndex(i);
-	
-			if (!Object)
-				continue;
-			
-			if (Object->HasTypeFlag(RequiredType) && Object->GetName() == Name)
-			{
-				return static_cast<UEType*>(Object);
-			}
-		}
-
-		return nullptr;
+		return static_cast<UEType*>(FObjectNameIndex::FindByName(Name, RequiredType));
 	}
 
 
@@ -753,6 +734,51 @@ public:
 
 };
 
+template<typename BufferType>
+void UObject::AppendFullName(BufferType& Buffer) const
+{
+	if (!Class)
+	{
+		Buffer.append("None", "None" + 4);
+		return;
+	}
+
+	// nearly every chain fits on the stack, a deeper one moves to the heap instead of losing its outermost outers
+	const UObject* InlineOuters[64];
+	std::vector<const UObject*> HeapOuters;
+	int32 NumOuters = 0;
+
+	for (const UObject* NextOuter = Outer; NextOuter; NextOuter = NextOuter->Outer)
+	{
+		if (NumOuters < 64)
+		{
+			InlineOuters[NumOuters] = NextOuter;
+		}
+		else
+		{
+			if (HeapOuters.empty())
+				HeapOuters.assign(InlineOuters, InlineOuters + 64);
+
+			HeapOuters.push_back(NextOuter);
+		}
+
+		NumOuters++;
+	}
+
+	const UObject* const* Outers = HeapOuters.empty() ? InlineOuters : HeapOuters.data();
+
+	Class->Name.AppendTo(Buffer);
+	Buffer.append(" ", " " + 1);
+
+	for (int32 i = NumOuters - 1; i >= 0; i--)
+	{
+		Outers[i]->Name.AppendTo(Buffer);
+		Buffer.append(".", "." + 1);
+	}
+
+	Name.AppendTo(Buffer);
+}
+
 }
 
 
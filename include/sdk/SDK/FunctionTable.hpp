@@ -0,0 +1,53 @@
+#pragma once
+
+// Every UFunction the loader calls or watches for in the ProcessEvent hook, resolved once at startup by FFunctionTable::Resolve().
+// SDK_FUNCTION(Id, Package, Class, Function) - Class is the class declaring the function, not a subclass
+#define SDK_FUNCTION_LIST(SDK_FUNCTION)                                                                    \
+    SDK_FUNCTION(PalUtility_GetPalGameStateInGame, "Pal", "PalUtility", "GetPalGameStateInGame")           \
+    SDK_FUNCTION(PalUtility_SendSystemAnnounce, "Pal", "PalUtility", "SendSystemAnnounce")                 \
+    SDK_FUNCTION(PalUtility_GetAllPlayerCharacters, "Pal", "PalUtility", "GetAllPlayerCharacters")         \
+    SDK_FUNCTION(PalUtility_GetPlayerStateByPlayer, "Pal", "PalUtility", "GetPlayerStateByPlayer")         \
+    SDK_FUNCTION(PalUtility_GetPlayerUIDByActor, "Pal", "PalUtility", "GetPlayerUIDByActor")               \
+    SDK_FUNCTION(PalUtility_IsDevelopmentBuild, "Pal", "PalUtility", "IsDevelopmentBuild")                 \
+    SDK_FUNCTION(PalGameStateInGame_GetWorldName, "Pal", "PalGameStateInGame", "GetWorldName")             \
+    SDK_FUNCTION(PalGameStateInGame_GetServerFrameTime, "Pal", "PalGameStateInGame", "GetServerFrameTime") \
+    SDK_FUNCTION(PalGameStateInGame_GetMaxPlayerNum, "Pal", "PalGameStateInGame", "GetMaxPlayerNum")       \
+    SDK_FUNCTION(PlayerState_GetPlayerName, "Engine", "PlayerState", "GetPlayerName")                      \
+    SDK_FUNCTION(PlayerState_GetPlayerId, "Engine", "PlayerState", "GetPlayerId")                          \
+    SDK_FUNCTION(Pawn_GetController, "Engine", "Pawn", "GetController")                                    \
+    SDK_FUNCTION(GameModeBase_K2_OnLogout, "Engine", "GameModeBase", "K2_OnLogout")                        \
+    SDK_FUNCTION(PalPlayerState_EnterChat_Receive, "Pal", "PalPlayerState", "EnterChat_Receive")
+
+namespace SDK {
+
+    enum class EFunctionId : uint16 {
+#define SDK_FUNCTION_ID(Id, Package, Class, Function) Id,
+        SDK_FUNCTION_LIST(SDK_FUNCTION_ID)
+#undef SDK_FUNCTION_ID
+            Num,
+    };
+
+    // Flat UFunction table indexed by EFunctionId.
+    // Filled before any game code runs and read-only afterwards, so lookups need neither a lock nor a null check.
+    class FFunctionTable {
+        public:
+            // Resolve - resolves every listed function in parallel, returns false if any is missing ["Function Pal.PalUtility.GetWorldName"]
+            static bool Resolve(std::vector<std::string> *OutMissing = nullptr);
+
+            static inline class UFunction *Get(EFunctionId Id) {
+                return Functions[static_cast<uint16>(Id)];
+            }
+
+            static const char *GetFullName(EFunctionId Id);
+
+        private:
+            static inline class UFunction *Functions[static_cast<uint16>(EFunctionId::Num)] = {};
+    };
+
+    // CallFunction - ProcessEvent through the table, what a wrapper looks like once its function is in SDK_FUNCTION_LIST
+    template<typename ParamsType>
+    inline void CallFunction(const UObject *Object, EFunctionId Id, ParamsType &Parms) {
+        Object->ProcessEvent(FFunctionTable::Get(Id), &Parms);
+    }
+
+} // namespace SDK
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// IDA style byte pattern ["48 8B 05 ?? ?? ?? ?? 48 8B 0C C8"], "?" and "??" are wildcards.
+struct BytePattern {
+    std::vector<uint8_t> bytes; // already masked, wildcards are 0
+    std::vector<uint8_t> mask;  // 0xFF must match, 0x00 wildcard
+    size_t               first_solid = 0;
+    size_t               last_solid  = 0;
+
+    static std::optional<BytePattern> parse(std::string_view text);
+
+    inline size_t size() const {
+        return bytes.size();
+    }
+};
+
+struct PatternMatch {
+    const uint8_t *first = nullptr; // lowest matching address
+    size_t         count = 0;       // stops counting at 2, anything above 1 is ambiguous
+};
+
+// scan_patterns - scans [data, data + size) for every pattern at once, one PatternMatch per pattern.
+// The buffer is split into chunks that are scanned in parallel, every pattern runs over a chunk while it is still in cache.
+std::vector<PatternMatch> scan_patterns(const uint8_t *data, size_t size, const std::vector<BytePattern> &patterns);
+
+// find_pattern - first match of a single pattern, nullptr if there is none
+const uint8_t *find_pattern(const uint8_t *data, size_t size, const BytePattern &pattern);
+
+// scanner_uses_avx2 - whether this CPU takes the AVX2 path, SSE2 otherwise
+bool scanner_uses_avx2();
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "world_snapshot.h"
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// Binary telemetry frames for high rate pollers [GET /telemetry], rendered from the world snapshot.
+// Everything is little-endian with no padding. A full frame is TelemetryHeader followed by TelemetrySample,
+// both readable with one memcpy each. A delta frame carries only the sample fields that changed since
+// base_sequence, in field order, and field_mask says which:
+//
+//   memcpy(&header, frame, sizeof(header));
+//   if (header.flags & TelemetryDelta) {
+//       auto fields = reinterpret_cast<uint32_t *>(&sample); auto in = frame + sizeof(header);
+//       for (int i = 0; i < TelemetryNumFields; i++) if (header.field_mask >> i & 1) memcpy(&fields[i], in, 4), in += 4;
+//   } else memcpy(&sample, frame + sizeof(header), sizeof(sample));
+//
+// Samples are only as fresh as the snapshot, set snapshot_interval_ms to the polling interval [50 for 20 Hz].
+
+static_assert(std::endian::native == std::endian::little, "telemetry frames are written as they lie in memory");
+
+constexpr uint32_t TelemetryMagic         = 0x544c4150; // "PALT"
+constexpr uint16_t TelemetrySchemaVersion = 1;
+
+// TelemetryHeader::flags
+constexpr uint16_t TelemetryDelta = 1 << 0;
+
+#pragma pack(push, 1)
+struct TelemetryHeader {
+        uint32_t length;         // whole frame, header included
+        uint32_t magic;          // TelemetryMagic
+        uint16_t version;        // TelemetrySchemaVersion, fields are only ever appended
+        uint16_t flags;          // TelemetryDelta
+        uint32_t field_mask;     // bit i set: field i is in the frame
+        uint64_t sequence;       // snapshot sequence of the sample
+        uint64_t base_sequence;  // the sample a delta applies to, 0 for a full frame
+        int64_t  captured_at_ms; // unix time of the snapshot
+};
+
+// Every field is 4 bytes, field i sits at offset 4 * i
+struct TelemetrySample {
+        float   server_frame_time;
+        int32_t player_count;
+        int32_t max_player_num;
+        int32_t wild_monster_count;
+        int32_t otomo_monster_count;
+        int32_t base_camp_monster_count;
+        int32_t npc_count;
+        int32_t other_character_count;
+        int32_t base_camp_count;
+        int32_t nav_mesh_invoker_count;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TelemetryHeader) == 40);
+
+constexpr int TelemetryNumFields = sizeof(TelemetrySample) / 4;
+
+namespace telemetry {
+    TelemetrySample sample(const WorldSnapshot &snapshot);
+
+    // write_frame - a delta against base_sequence if that sample is still remembered, otherwise a full frame
+    std::string write_frame(const WorldSnapshot &snapshot, std::optional<uint64_t> base_sequence);
+} // namespace telemetry
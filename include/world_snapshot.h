@@ -0,0 +1,102 @@
+#pragma once
+
+#include "commands.h"
+#include "json_writer.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Copy of the world state that readers on any thread can use without touching UObjects.
+// The game thread captures one every interval into a triple buffer. Readers pin the latest one with a couple of atomics
+// and never wait for the game thread.
+
+struct PlayerSnapshot {
+        std::string  name;
+        std::string  guild;
+        std::string  address;
+        uint32_t     uid       = 0;
+        int32_t      player_id = 0;
+        int32_t      ping_ms   = 0;
+        SDK::FVector location {};
+};
+
+struct WorldSnapshot {
+        uint64_t                              sequence = 0;
+        std::chrono::system_clock::time_point captured_at;
+
+        std::string world_name;
+        std::string save_directory;
+        float       frame_time     = 0;
+        int32_t     max_player_num = 0;
+
+        int32_t wild_monster_count      = 0;
+        int32_t otomo_monster_count     = 0;
+        int32_t base_camp_monster_count = 0;
+        int32_t npc_count               = 0;
+        int32_t other_character_count   = 0;
+        int32_t base_camp_count         = 0;
+        int32_t nav_mesh_invoker_count  = 0;
+
+        // AllUpdate, Nearest, Near, MidInSight, FarInSight, MidOutSight, FarOutSight, Farthest
+        int32_t importance_character_count[8] = {};
+
+        std::vector<PlayerSnapshot> players;
+
+        // find_player - nullptr if no player has this UID ["0123abcd"]
+        const PlayerSnapshot *find_player(std::string_view uid_text) const;
+};
+
+namespace world_snapshot {
+    // Pins one published snapshot, it is not reused while a SnapshotRef to it exists
+    class SnapshotRef {
+        public:
+            SnapshotRef() = default;
+            SnapshotRef(SnapshotRef &&other) noexcept;
+            SnapshotRef &operator=(SnapshotRef &&other) noexcept;
+            ~SnapshotRef();
+
+            SnapshotRef(const SnapshotRef &)            = delete;
+            SnapshotRef &operator=(const SnapshotRef &) = delete;
+
+            explicit operator bool() const {
+                return snapshot != nullptr;
+            }
+
+            const WorldSnapshot &operator*() const {
+                return *snapshot;
+            }
+
+            const WorldSnapshot *operator->() const {
+                return snapshot;
+            }
+
+        private:
+            friend SnapshotRef acquire();
+
+            SnapshotRef(int in_slot, const WorldSnapshot *in_snapshot) : slot(in_slot), snapshot(in_snapshot) {}
+
+            int                  slot     = -1;
+            const WorldSnapshot *snapshot = nullptr;
+    };
+
+    // start - capture from context every interval, from then on tick() publishes
+    void start(std::shared_ptr<SDKContext> context, std::chrono::milliseconds interval);
+
+    // tick - called by the ProcessEvent hook, publishes when the interval elapsed, no-op off the game thread
+    void tick();
+
+    // publish - captures and publishes now, game thread only [or any thread while the game thread isn't attached]
+    bool publish();
+
+    // acquire - the latest snapshot, empty before the first publish
+    SnapshotRef acquire();
+
+    // write_state_json - per_snapshot false leaves out what changes with every snapshot [frame time, sequence, capture time]
+    void write_state_json(const WorldSnapshot &snapshot, JsonWriter &json, bool per_snapshot = true);
+    void write_players_json(const WorldSnapshot &snapshot, JsonWriter &json);
+    void write_player_json(const PlayerSnapshot &player, JsonWriter &json);
+} // namespace world_snapshot
@@ -0,0 +1,200 @@
+#include "admission.h"
+#include "metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct TokenBucket {
+            double            tokens = 0;
+            Clock::time_point updated;
+
+            void refill(Clock::time_point now, double rate, double burst) {
+                // a new bucket starts full
+                tokens  = updated == Clock::time_point() ? burst : std::min(burst, tokens + std::chrono::duration<double>(now - updated).count() * rate);
+                updated = now;
+            }
+
+            // wait - time until the bucket holds tokens
+            std::chrono::milliseconds wait(double wanted, double rate) const {
+                return std::chrono::milliseconds(static_cast<int64_t>(std::ceil((wanted - tokens) / rate * 1000)));
+            }
+    };
+
+    struct Client {
+            TokenBucket read;
+            TokenBucket write;
+    };
+
+    struct StringHash {
+            using is_transparent = void;
+
+            size_t operator()(std::string_view text) const {
+                return std::hash<std::string_view>()(text);
+            }
+    };
+
+    // clients are spread over shards by hash, two I/O threads rarely wait for the same lock
+    constexpr size_t NumShards = 16;
+    constexpr size_t MinSweep  = 1024;
+
+    struct Shard {
+            std::mutex                                                           lock;
+            std::unordered_map<std::string, Client, StringHash, std::equal_to<>> clients;
+            size_t                                                               sweep_at = MinSweep; // clients before idle ones are dropped
+    };
+
+    AdmissionOptions                                             options;
+    std::unordered_set<std::string, StringHash, std::equal_to<>> known_tokens;
+    std::array<Shard, NumShards>                                 shards;
+    std::mutex                                                   global_lock;
+    TokenBucket                                                  global; // game thread tasks, every client together
+
+    // sweep - drops clients whose buckets refilled, they start out full again when they come back
+    void sweep(Shard &shard, Clock::time_point now) {
+        auto idle = std::chrono::duration<double>(std::max(options.read_rate > 0 ? options.read_burst / options.read_rate : 0.0, options.write_rate > 0 ? options.write_burst / options.write_rate : 0.0));
+
+        std::erase_if(shard.clients, [&](const auto &item) {
+            return now - std::max(item.second.read.updated, item.second.write.updated) > idle;
+        });
+
+        shard.sweep_at = std::max(MinSweep, shard.clients.size() * 2);
+    }
+
+    // bucket - the client's bucket for cost, shard lock held. Never sweeps, buckets looked up before stay valid.
+    TokenBucket &bucket(Shard &shard, std::string_view client, bool write) {
+        auto it = shard.clients.find(client);
+        if (it == shard.clients.end()) {
+            it = shard.clients.emplace(std::string(client), Client()).first;
+        }
+
+        return write ? it->second.write : it->second.read;
+    }
+
+    Admission reject(RequestCost cost, std::chrono::milliseconds retry_after) {
+        (cost == RequestCost::read ? metrics::admission_rejected_reads : metrics::admission_rejected_writes).fetch_add(1, std::memory_order_relaxed);
+        return { false, std::max(retry_after, std::chrono::milliseconds(1)) };
+    }
+
+    Admission never(RequestCost cost) {
+        (cost == RequestCost::read ? metrics::admission_rejected_reads : metrics::admission_rejected_writes).fetch_add(1, std::memory_order_relaxed);
+        return { false, {}, true };
+    }
+
+    Shard &shard_of(std::string_view client) {
+        return shards[StringHash()(client) % NumShards];
+    }
+
+    // sweep_if_full - before any bucket of the shard is looked up, the sweep would drop a fresh one
+    void sweep_if_full(Shard &shard, Clock::time_point now) {
+        if (shard.clients.size() >= shard.sweep_at) {
+            sweep(shard, now);
+        }
+    }
+
+    // take - tokens from the client buckets [locked by the caller] and for a game thread task one from the global bucket, all or nothing
+    Admission take(RequestCost cost, double tokens, bool game_thread_task, TokenBucket *address_bucket, TokenBucket *token_bucket, Clock::time_point now) {
+        const bool   write = cost == RequestCost::write;
+        const double rate  = write ? options.write_rate : options.read_rate;
+        const double burst = write ? options.write_burst : options.read_burst;
+
+        for (auto *client_bucket : { address_bucket, token_bucket }) {
+            if (!client_bucket) {
+                continue;
+            }
+
+            client_bucket->refill(now, rate, burst);
+
+            if (client_bucket->tokens < tokens) {
+                return reject(cost, client_bucket->wait(tokens, rate));
+            }
+        }
+
+        if (write && game_thread_task && options.game_thread_tasks > 0) {
+            std::lock_guard lock(global_lock);
+
+            const double global_rate = options.game_thread_tasks / std::chrono::duration<double>(options.window).count();
+
+            global.refill(now, global_rate, options.game_thread_tasks);
+
+            if (global.tokens < 1) {
+                return reject(cost, global.wait(1, global_rate));
+            }
+            global.tokens -= 1;
+        }
+
+        for (auto *client_bucket : { address_bucket, token_bucket }) {
+            if (client_bucket) {
+                client_bucket->tokens -= tokens;
+            }
+        }
+        return { true, {} };
+    }
+} // namespace
+
+namespace admission {
+    void configure(const AdmissionOptions &in_options) {
+        options = in_options;
+        known_tokens.clear();
+        known_tokens.insert(options.tokens.begin(), options.tokens.end());
+    }
+
+    double max_tokens(RequestCost cost) {
+        const bool write = cost == RequestCost::write;
+        double     limit = std::numeric_limits<double>::infinity();
+
+        if ((write ? options.write_rate : options.read_rate) > 0) {
+            limit = write ? options.write_burst : options.read_burst;
+        }
+        return limit;
+    }
+
+    Admission admit(std::string_view address, std::string_view token, RequestCost cost, double tokens, bool game_thread_task) {
+        const bool write = cost == RequestCost::write;
+        const auto now   = Clock::now();
+
+        // a bucket can never hold this many, waiting would not help
+        if (tokens > max_tokens(cost) || (write && game_thread_task && options.game_thread_tasks > 0 && options.game_thread_tasks < 1)) {
+            return never(cost);
+        }
+
+        if ((write ? options.write_rate : options.read_rate) <= 0) {
+            return take(cost, tokens, game_thread_task, nullptr, nullptr, now);
+        }
+
+        auto &address_shard = shard_of(address);
+
+        // an unknown token would be a fresh bucket per made up value, only configured ones get their own
+        if (token.empty() || !known_tokens.contains(token)) {
+            std::lock_guard lock(address_shard.lock);
+
+            sweep_if_full(address_shard, now);
+            return take(cost, tokens, game_thread_task, &bucket(address_shard, address, write), nullptr, now);
+        }
+
+        auto  token_key   = "token:" + std::string(token);
+        auto &token_shard = shard_of(token_key);
+
+        std::unique_lock address_lock(address_shard.lock, std::defer_lock);
+        std::unique_lock token_lock(token_shard.lock, std::defer_lock);
+
+        if (&token_shard == &address_shard) {
+            address_lock.lock();
+        } else {
+            std::lock(address_lock, token_lock);
+        }
+
+        sweep_if_full(address_shard, now);
+        sweep_if_full(token_shard, now);
+        return take(cost, tokens, game_thread_task, &bucket(address_shard, address, write), &bucket(token_shard, token_key, write), now);
+    }
+} // namespace admission
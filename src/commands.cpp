@@ -0,0 +1,275 @@
+#include "commands.h"
+#include "event_stream.h"
+#include "game_fields.h"
+#include "game_functions.h"
+#include "metrics.h"
+#include "spdlog/spdlog.h"
+#include "utils.h"
+
+#include <charconv>
+#include <optional>
+
+namespace {
+    // parse_uid - UIDs are printed as 8 hex digits ["0123abcd"], any case
+    std::optional<uint32_t> parse_uid(std::string_view uid_text) {
+        uint32_t uid = 0;
+
+        if (uid_text.size() != 8) {
+            return std::nullopt;
+        }
+
+        auto [end, ec] = std::from_chars(uid_text.data(), uid_text.data() + uid_text.size(), uid, 16);
+        if (ec != std::errc() || end != uid_text.data() + uid_text.size()) {
+            return std::nullopt;
+        }
+        return uid;
+    }
+
+    std::string dispatch_command(const ParsedCommand &command, const SDKContext &context, PlayerIndex &players) {
+        switch (command.kind) {
+            case CommandKind::state:
+                return command_state(context);
+            case CommandKind::broadcast:
+                return command_broadcast(context, command.argument);
+            case CommandKind::gc:
+                return command_gc(context);
+            case CommandKind::list:
+                return command_list(context);
+            case CommandKind::kick:
+                return command_kick(context, players, command.argument).value_or("No player kicked\n");
+        }
+
+        return "Unknown command\n";
+    }
+
+    LatencyHistogram &command_latency(std::string_view name) {
+        return metrics::histogram("pal_command_duration_seconds", "Time commands ran for on the game thread, by command.", metrics::label("command", name));
+    }
+} // namespace
+
+std::optional<ParsedCommand> parse_command(std::string_view text, std::string *error) {
+    auto fail = [error](const char *reason) -> std::optional<ParsedCommand> {
+        if (error) {
+            *error = reason;
+        }
+        return std::nullopt;
+    };
+
+    auto space    = text.find(' ');
+    auto name     = text.substr(0, space);
+    auto argument = space == std::string_view::npos ? std::string_view() : text.substr(space + 1);
+
+    if (name == "state" && space == std::string_view::npos) {
+        return ParsedCommand { CommandKind::state, {} };
+    }
+    if (name == "gc" && space == std::string_view::npos) {
+        return ParsedCommand { CommandKind::gc, {} };
+    }
+    if (name == "list" && space == std::string_view::npos) {
+        return ParsedCommand { CommandKind::list, {} };
+    }
+    if (name == "broadcast") {
+        if (argument.empty()) {
+            return fail("Missing broadcast message");
+        }
+        return ParsedCommand { CommandKind::broadcast, std::string(argument) };
+    }
+    if (name == "kick") {
+        if (!parse_uid(argument)) {
+            return fail("Invalid UID");
+        }
+        return ParsedCommand { CommandKind::kick, std::string(argument) };
+    }
+
+    return fail("Unknown command");
+}
+
+SDK::APalPlayerState *PlayerIndex::find(std::string_view uid_text) {
+    auto uid = parse_uid(uid_text);
+    if (!uid) {
+        return nullptr;
+    }
+
+    if (!built) {
+        build();
+    }
+
+    auto it = players.find(*uid);
+    return it != players.end() ? it->second : nullptr;
+}
+
+void PlayerIndex::remove(SDK::APalPlayerState *state) {
+    std::erase_if(players, [state](const auto &item) {
+        return item.second == state;
+    });
+}
+
+void PlayerIndex::build() {
+    built = true;
+
+    // PlayerArray is read directly, GetAllPlayerCharacters + GetPlayerUIDByActor cost a ProcessEvent per player
+    auto &player_states = context.stateInGame->PlayerArray;
+
+    for (int i = 0; i < player_states.Num(); i++) {
+        auto player_state = player_states[i];
+
+        // players still logging in have no pawn yet, they were never found by UID
+        if (!player_state || !player_state->PawnPrivate || !player_state->IsA(SDK::APalPlayerState::StaticClass())) {
+            continue;
+        }
+
+        auto pal_state = static_cast<SDK::APalPlayerState *>(player_state);
+        players.emplace(static_cast<uint32_t>(APalPlayerState_PlayerUId.Get(pal_state).A), pal_state);
+    }
+}
+
+std::string player_address(SDK::APlayerController *controller) {
+    if (controller && controller->NetConnection && LowLevelGetRemoteAddress) {
+        auto fsaddress = LowLevelGetRemoteAddress(static_cast<SDK::UIpConnection *>(controller->NetConnection), true);
+
+        if (fsaddress && fsaddress->IsValid() && fsaddress->Num() > 1) {
+            return fsaddress->ToString();
+        }
+    }
+
+    return std::string("[UNK]");
+}
+
+std::string command_state(const SDKContext &context) {
+    auto world_name     = game_functions::get_world_name(context.stateInGame).ToString();
+    auto save_directory = APalGameStateInGame_WorldSaveDirectoryName.Get(context.stateInGame).ToString();
+    auto frame_time     = game_functions::get_server_frame_time(context.stateInGame);
+    auto max_player     = game_functions::get_max_player_num(context.stateInGame);
+
+    spdlog::info("[CMD::State] WorldName               = {}", world_name);
+    spdlog::info("[CMD::State] World Save Directory    = {}", save_directory);
+    spdlog::info("[CMD::State] Server Frame Time       = {}", frame_time);
+    spdlog::info("[CMD::State] Max Player              = {}", max_player);
+
+    return fmt::format("WorldName = {}\nWorld Save Directory = {}\nServer Frame Time = {}\nMax Player = {}\n", world_name, save_directory, frame_time, max_player);
+}
+
+std::string command_broadcast(const SDKContext &context, const std::string &message_utf8) {
+    std::wstring message_utf16 = utf8_to_utf16(message_utf8);
+
+    game_functions::send_system_announce(context.utility, context.world, SDK::FString(message_utf16.c_str()));
+
+    spdlog::info("[CMD::BroadcastChatMessage] {}", wide_to_narrow(message_utf16));
+
+    events::publish(EventType::Broadcast, [&](JsonWriter &json) {
+        json.field("message", message_utf8);
+    });
+    return "Broadcast: " + message_utf8 + "\n";
+}
+
+std::string command_gc(const SDKContext &context) {
+    if (!context.forceGarbageCollection) {
+        return "ForceGarbageCollection unavailable, its offset doesn't match this server build\n";
+    }
+
+    context.forceGarbageCollection(context.engine, true);
+
+    spdlog::info("[CMD::ForceGarbageCollection] done");
+    return "ForceGarbageCollection done\n";
+}
+
+std::string command_list(const SDKContext &context) {
+    auto player_characters = game_functions::get_all_player_characters(context.utility, context.world);
+
+    if (!player_characters.IsValid()) {
+        return "0 player online\n";
+    }
+
+    spdlog::info("[CMD::List] current {} player online", player_characters.Num());
+    std::string reply = fmt::format("{} player online\n", player_characters.Num());
+
+    for (int i = 0; i < player_characters.Num(); i++) {
+        auto character = static_cast<SDK::APalPlayerCharacter *>(player_characters[i]);
+        auto address   = player_address(static_cast<SDK::APlayerController *>(game_functions::get_controller(character)));
+        auto state     = game_functions::get_player_state_by_player(context.utility, character);
+        auto raw_name  = game_functions::get_player_name(state);
+        auto uid       = game_functions::get_player_uid_by_actor(context.utility, character);
+
+        spdlog::info("[CMD::List] {}, {:08x}, {}", utf16_to_local_codepage(raw_name.Data, raw_name.NumElements), static_cast<uint32_t>(uid.A), address);
+        reply += fmt::format("{}, {:08x}, {}\n", utf16_to_utf8(raw_name.Data, raw_name.NumElements), static_cast<uint32_t>(uid.A), address);
+    }
+
+    return reply;
+}
+
+std::optional<std::string> command_player(const SDKContext &context, const std::string &uid_text) {
+    PlayerIndex players(context);
+
+    auto state = players.find(uid_text);
+    if (!state) {
+        return std::nullopt;
+    }
+
+    auto &name       = state->PlayerNamePrivate;
+    auto  uid        = APalPlayerState_PlayerUId.Get(state);
+    auto  controller = static_cast<SDK::APlayerController *>(state->Owner);
+
+    return fmt::format("Name = {}\nUID = {:08x}\nPlayer Id = {}\nAddress = {}\n", utf16_to_utf8(name.Data, name.NumElements), static_cast<uint32_t>(uid.A), state->PlayerId, player_address(controller));
+}
+
+std::optional<std::string> command_kick(const SDKContext &context, const std::string &uid_text) {
+    PlayerIndex players(context);
+    return command_kick(context, players, uid_text);
+}
+
+std::optional<std::string> command_kick(const SDKContext &context, PlayerIndex &players, std::string_view uid_text) {
+    if (!KickPlayer || !GetEmptyFText) {
+        return "Kick unavailable, its offsets don't match this server build\n";
+    }
+
+    auto state = players.find(uid_text);
+    if (!state) {
+        return std::nullopt;
+    }
+
+    auto        uid      = APalPlayerState_PlayerUId.Get(state);
+    auto       &raw_name = state->PlayerNamePrivate;
+    SDK::FText *reason   = GetEmptyFText();
+
+    if (!KickPlayer(context.world, &uid, reason)) {
+        return "Kick failed\n";
+    }
+
+    players.remove(state);
+
+    spdlog::info("[CMD::Kick] player {} kicked", utf16_to_local_codepage(raw_name.Data, raw_name.NumElements));
+
+    events::publish(EventType::Kick, [&](JsonWriter &json) {
+        json.key("name");
+        json.value_utf16(raw_name.Data, raw_name.NumElements);
+        json.key("uid");
+        json.value_hex32(static_cast<uint32_t>(uid.A));
+    });
+    return "Kicked " + utf16_to_utf8(raw_name.Data, raw_name.NumElements) + "\n";
+}
+
+std::string run_command(const ParsedCommand &command, const SDKContext &context, PlayerIndex &players) {
+    // indexed by CommandKind
+    static LatencyHistogram *const latency[] = {
+        &command_latency("state"), &command_latency("broadcast"), &command_latency("gc"), &command_latency("list"), &command_latency("kick"),
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    auto reply = dispatch_command(command, context, players);
+
+    latency[static_cast<size_t>(command.kind)]->record(std::chrono::steady_clock::now() - start);
+    return reply;
+}
+
+std::string execute_command(const std::string &text, const SDKContext &context) {
+    std::string error;
+
+    auto command = parse_command(text, &error);
+    if (!command) {
+        spdlog::info("[CMD::???] {}", error);
+        return error + "\n";
+    }
+
+    PlayerIndex players(context);
+    return run_command(*command, context, players);
+}
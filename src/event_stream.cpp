@@ -0,0 +1,269 @@
+#include "event_stream.h"
+#include "spdlog/spdlog.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+    constexpr const char *event_type_names[] = { "login", "logout", "chat", "kick", "broadcast" };
+
+    static_assert(sizeof(event_type_names) / sizeof(event_type_names[0]) == static_cast<size_t>(EventType::Num), "event_type_names and EventType are out of sync!");
+} // namespace
+
+const char *event_type_name(EventType type) {
+    return event_type_names[static_cast<size_t>(type)];
+}
+
+std::optional<uint32_t> parse_event_types(std::string_view names) {
+    uint32_t mask = 0;
+
+    while (!names.empty()) {
+        auto comma = names.find(',');
+        auto name  = names.substr(0, comma);
+
+        names = comma == std::string_view::npos ? std::string_view() : names.substr(comma + 1);
+
+        if (name.empty()) {
+            continue;
+        }
+
+        bool known = false;
+        for (size_t i = 0; i < static_cast<size_t>(EventType::Num); i++) {
+            if (name == event_type_names[i]) {
+                mask |= 1u << i;
+                known = true;
+                break;
+            }
+        }
+
+        if (!known) {
+            return std::nullopt;
+        }
+    }
+
+    return mask;
+}
+
+namespace events {
+    namespace {
+        namespace websocket = beast::websocket;
+
+        // events per WebSocket message, a subscriber that is further behind sends several
+        constexpr size_t MaxBatch = 256;
+
+        std::atomic<std::shared_ptr<const Event>> ring[EventCapacity];
+        std::atomic<uint64_t>                     next_sequence = 0;
+        std::mutex                                producer_lock;
+
+        class Subscriber;
+
+        std::optional<net::any_io_executor>    notify_executor;
+        std::atomic<bool>                      notify_pending = false;
+        std::mutex                             subscribers_lock;
+        std::vector<std::weak_ptr<Subscriber>> subscribers;
+
+        // One WebSocket client. Everything runs on the connection's strand.
+        class Subscriber : public std::enable_shared_from_this<Subscriber> {
+            public:
+                Subscriber(tcp::socket &&socket, uint32_t in_type_mask) : ws(std::move(socket)), type_mask(in_type_mask) {}
+
+                void run(HttpRequest &&request) {
+                    // idle subscribers are normal here, pings keep the connection and tell us when the client is gone
+                    auto timeout             = websocket::stream_base::timeout::suggested(beast::role_type::server);
+                    timeout.keep_alive_pings = true;
+
+                    ws.set_option(timeout);
+                    ws.set_option(websocket::stream_base::decorator([](websocket::response_type &response) {
+                        response.set(http::field::server, "Boost.Beast");
+                    }));
+
+                    ws.async_accept(request, beast::bind_front_handler(&Subscriber::on_accept, shared_from_this()));
+                }
+
+                // wake - new events were pushed, safe to call from any thread
+                void wake() {
+                    net::dispatch(ws.get_executor(), beast::bind_front_handler(&Subscriber::do_write, shared_from_this()));
+                }
+
+            private:
+                void on_accept(beast::error_code ec) {
+                    if (ec) {
+                        spdlog::debug("WebSocket handshake failed: {}", ec.message());
+                        return;
+                    }
+
+                    cursor = head();
+
+                    {
+                        std::lock_guard lock(subscribers_lock);
+                        subscribers.push_back(weak_from_this());
+                    }
+
+                    do_read();
+                    do_write();
+                }
+
+                // clients don't send anything, the read is there for pings and the close handshake
+                void do_read() {
+                    ws.async_read(read_buffer, beast::bind_front_handler(&Subscriber::on_read, shared_from_this()));
+                }
+
+                void on_read(beast::error_code ec, std::size_t) {
+                    if (ec) {
+                        closed = true;
+                        return;
+                    }
+
+                    read_buffer.clear();
+                    do_read();
+                }
+
+                void do_write() {
+                    if (writing || closed) {
+                        return;
+                    }
+
+                    const uint64_t last = head();
+
+                    // lapped by the producer, skip what the ring no longer holds
+                    if (last - cursor > EventCapacity) {
+                        dropped += last - EventCapacity - cursor;
+                        cursor = last - EventCapacity;
+                    }
+
+                    while (cursor < last && batch.size() < MaxBatch) {
+                        auto event = get(cursor++);
+
+                        if (!event) {
+                            dropped++;
+                            continue;
+                        }
+
+                        if (type_mask & (1u << static_cast<uint32_t>(event->type))) {
+                            batch.push_back(std::move(event));
+                        }
+                    }
+
+                    if (batch.empty() && dropped == 0) {
+                        return;
+                    }
+
+                    // one message per batch, a JSON array over the shared payloads
+                    buffers.clear();
+                    buffers.push_back(net::buffer("[", 1));
+
+                    if (dropped) {
+                        dropped_json = fmt::format(R"({{"type":"dropped","count":{}}})", dropped);
+                        dropped      = 0;
+
+                        buffers.push_back(net::buffer(dropped_json));
+                    }
+
+                    for (auto &event : batch) {
+                        if (buffers.size() > 1) {
+                            buffers.push_back(net::buffer(",", 1));
+                        }
+                        buffers.push_back(net::buffer(event->json));
+                    }
+
+                    buffers.push_back(net::buffer("]", 1));
+
+                    writing = true;
+
+                    ws.text(true);
+                    ws.async_write(buffers, beast::bind_front_handler(&Subscriber::on_write, shared_from_this()));
+                }
+
+                void on_write(beast::error_code ec, std::size_t) {
+                    writing = false;
+                    batch.clear();
+
+                    if (ec) {
+                        closed = true;
+                        return;
+                    }
+
+                    do_write();
+                }
+
+                websocket::stream<beast::tcp_stream>      ws;
+                beast::flat_buffer                        read_buffer;
+                uint32_t                                  type_mask;
+                uint64_t                                  cursor  = 0;
+                uint64_t                                  dropped = 0;
+                std::vector<std::shared_ptr<const Event>> batch;
+                std::vector<net::const_buffer>            buffers;
+                std::string                               dropped_json;
+                bool                                      writing = false;
+                bool                                      closed  = false;
+        };
+
+        // notify_subscribers - runs on an I/O thread, once per burst of pushes
+        void notify_subscribers() {
+            notify_pending.store(false);
+
+            std::lock_guard lock(subscribers_lock);
+
+            std::erase_if(subscribers, [](const std::weak_ptr<Subscriber> &weak) {
+                auto subscriber = weak.lock();
+                if (!subscriber) {
+                    return true;
+                }
+
+                subscriber->wake();
+                return false;
+            });
+        }
+    } // namespace
+
+    void start(net::any_io_executor executor) {
+        notify_executor = std::move(executor);
+    }
+
+    void push(EventType type, std::string_view fields) {
+        auto time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        {
+            // producers are serialized so sequence numbers land in the ring in order
+            std::lock_guard lock(producer_lock);
+
+            const uint64_t sequence = next_sequence.load(std::memory_order_relaxed);
+
+            auto event      = std::make_shared<Event>();
+            event->sequence = sequence;
+            event->type     = type;
+            event->json     = fmt::format(R"({{"seq":{},"type":"{}","time_ms":{}{}}})", sequence, event_type_name(type), time_ms, fields);
+
+            ring[sequence % EventCapacity].store(std::move(event));
+            next_sequence.store(sequence + 1, std::memory_order_release);
+        }
+
+        // subscribers are woken from an I/O thread, the producer never touches them
+        if (notify_executor && !notify_pending.exchange(true)) {
+            net::post(*notify_executor, notify_subscribers);
+        }
+    }
+
+    uint64_t head() {
+        return next_sequence.load(std::memory_order_acquire);
+    }
+
+    std::shared_ptr<const Event> get(uint64_t sequence) {
+        auto event = ring[sequence % EventCapacity].load();
+
+        if (!event || event->sequence != sequence) {
+            return nullptr;
+        }
+        return event;
+    }
+
+    void accept_subscriber(tcp::socket &&socket, HttpRequest &&request, uint32_t type_mask) {
+        std::make_shared<Subscriber>(std::move(socket), type_mask)->run(std::move(request));
+    }
+
+    size_t num_subscribers() {
+        std::lock_guard lock(subscribers_lock);
+        return subscribers.size();
+    }
+} // namespace events
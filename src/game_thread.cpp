@@ -0,0 +1,104 @@
+#include "game_thread.h"
+#include "metrics.h"
+#include "spdlog/spdlog.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace game_thread {
+    namespace {
+        MpscQueue                    queue;
+        std::atomic<std::thread::id> game_thread_id;
+        std::atomic<bool>            attached  = false;
+        std::atomic<bool>            expecting = false;
+
+        std::atomic<std::chrono::microseconds::rep> budget_us = 2000;
+        std::atomic<std::chrono::microseconds::rep> window_us = 16000;
+
+        // game thread only
+        thread_local bool                     in_pump = false;
+        std::chrono::steady_clock::time_point window_start;
+        std::chrono::steady_clock::duration   window_used {};
+    } // namespace
+
+    void attach_current_thread() {
+        bool expected = false;
+
+        if (attached.compare_exchange_strong(expected, true)) {
+            game_thread_id.store(std::this_thread::get_id(), std::memory_order_release);
+            spdlog::info("game thread attached");
+        }
+    }
+
+    bool is_attached() {
+        return attached.load(std::memory_order_acquire);
+    }
+
+    void expect_attach() {
+        expecting.store(true, std::memory_order_release);
+    }
+
+    bool is_queueing() {
+        return expecting.load(std::memory_order_acquire) || is_attached();
+    }
+
+    bool is_game_thread() {
+        return is_attached() && game_thread_id.load(std::memory_order_acquire) == std::this_thread::get_id();
+    }
+
+    void set_budget(std::chrono::microseconds budget, std::chrono::microseconds window) {
+        budget_us.store(budget.count(), std::memory_order_relaxed);
+        window_us.store(window.count(), std::memory_order_relaxed);
+    }
+
+    void enqueue(Task *task) {
+        task->enqueued_at = std::chrono::steady_clock::now();
+        queue.push(task);
+    }
+
+    void pump() {
+        // called for every ProcessEvent, the common case has to stay a couple of loads
+        if (in_pump || !is_game_thread() || queue.empty()) {
+            return;
+        }
+
+        in_pump = true;
+
+        const std::chrono::microseconds budget(budget_us.load(std::memory_order_relaxed));
+        const std::chrono::microseconds window(window_us.load(std::memory_order_relaxed));
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - window_start >= window) {
+            window_start = now;
+            window_used  = {};
+        }
+
+        // a task that overruns the budget still finishes, the rest wait for the next window
+        while (window_used < budget) {
+            std::unique_ptr<Task> task(static_cast<Task *>(queue.pop()));
+            if (!task) {
+                break;
+            }
+
+            metrics::game_thread_queue_wait.record(now - task->enqueued_at);
+
+            // pump runs inside ProcessEvent, nothing may unwind into the engine
+            try {
+                task->run();
+            } catch (std::exception const &e) {
+                spdlog::error("game thread task failed: {}", e.what());
+            } catch (...) {
+                spdlog::error("game thread task failed");
+            }
+            task.reset();
+
+            auto finished = std::chrono::steady_clock::now();
+            metrics::game_thread_task_duration.record(finished - now);
+            window_used += finished - now;
+            now = finished;
+        }
+
+        in_pump = false;
+    }
+} // namespace game_thread
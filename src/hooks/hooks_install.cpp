@@ -1,22 +1,52 @@
+#include "game_thread.h"
 #include "hooks.h"
+#include "spdlog/spdlog.h"
 
 SpawnPlayActorType engine_spawn_play_actor;
+ProcessEventType   engine_process_event;
 
 bool install_hooks() {
     funchook_t *funchook = funchook_create();
     int         rv;
 
-    engine_spawn_play_actor = reinterpret_cast<SpawnPlayActorType>(uintptr_t(GetImageBaseOffset()) + Offsets::SpawnPlayActor);
-    rv                      = funchook_prepare(funchook, (void **)&engine_spawn_play_actor, spawn_play_actor_proxy);
+    // an offset ResolveOffsets couldn't vouch for is 0, hooking whatever sits there would crash the server
+    if (Offsets::SpawnPlayActor) {
+        engine_spawn_play_actor = reinterpret_cast<SpawnPlayActorType>(uintptr_t(GetImageBaseOffset()) + Offsets::SpawnPlayActor);
+        rv                      = funchook_prepare(funchook, (void **)&engine_spawn_play_actor, spawn_play_actor_proxy);
+        if (rv != 0) {
+            goto clean_and_exit;
+        }
+    } else {
+        spdlog::error("SpawnPlayActor offset unknown, player join events disabled");
+    }
+
+    if (!Offsets::ProcessEvent) {
+        spdlog::error("ProcessEvent offset unknown");
+        goto clean_and_exit;
+    }
+
+    engine_process_event = reinterpret_cast<ProcessEventType>(uintptr_t(GetImageBaseOffset()) + Offsets::ProcessEvent);
+    rv                   = funchook_prepare(funchook, (void **)&engine_process_event, process_event_proxy);
     if (rv != 0) {
         goto clean_and_exit;
     }
 
+    // before the detour goes live, the table is in place for its first call
+    register_event_handlers();
+    game_thread_id = GetGameThreadId();
+
     rv = funchook_install(funchook, 0);
     if (rv != 0) {
         goto clean_and_exit;
     }
 
+    // without a thread to attach, nothing would ever pump the queue
+    if (game_thread_id) {
+        game_thread::expect_attach();
+    } else {
+        spdlog::error("game thread not found, commands run on the thread that issues them");
+    }
+
     return true;
 clean_and_exit:
     if (funchook) {
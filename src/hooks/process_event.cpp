@@ -0,0 +1,97 @@
+#include "hooks.h"
+#include "event_stream.h"
+#include "game_fields.h"
+#include "game_thread.h"
+#include "process_event_hooks.h"
+#include "world_snapshot.h"
+
+#include <windows.h>
+
+namespace {
+    // on_logout - GameModeBase.K2_OnLogout, the controller and its state are still alive here
+    void on_logout(const SDK::Params::AGameModeBase_K2_OnLogout_Params *params) {
+        auto controller = params->ExitingController;
+        if (!controller || !controller->PlayerState || !controller->PlayerState->IsA(SDK::APalPlayerState::StaticClass())) {
+            return;
+        }
+
+        auto state = static_cast<SDK::APalPlayerState *>(controller->PlayerState);
+        auto &name = state->PlayerNamePrivate;
+
+        events::publish(EventType::Logout, [&](JsonWriter &json) {
+            json.key("name");
+            json.value_utf16(name.Data, name.NumElements);
+            json.key("uid");
+            json.value_hex32(static_cast<uint32_t>(APalPlayerState_PlayerUId.Get(state).A));
+        });
+    }
+
+    // on_chat - PalPlayerState.EnterChat_Receive, the server side of a player's chat message
+    void on_chat(const SDK::Params::APalPlayerState_EnterChat_Receive_Params *params) {
+        auto &message = params->ChatMessage;
+
+        events::publish(EventType::Chat, [&](JsonWriter &json) {
+            json.key("sender");
+            json.value_utf16(message.Sender.Data, message.Sender.NumElements);
+            json.key("sender_uid");
+            json.value_hex32(static_cast<uint32_t>(message.SenderPlayerUId.A));
+            json.field("category", static_cast<int>(message.Category));
+            json.key("message");
+            json.value_utf16(message.Message.Data, message.Message.NumElements);
+        });
+    }
+
+    // ProcessEvent calls on this thread that run handlers and haven't returned, their Handlers are still in use
+    unsigned handler_depth = 0; // game thread only
+} // namespace
+
+uint32_t game_thread_id = 0;
+
+void process_event_proxy(const SDK::UObject *object, SDK::UFunction *function, void *params) {
+    // ProcessEvent also runs on whatever thread a command was issued from, only the engine's own game thread attaches
+    if (!game_thread::is_attached() && GetCurrentThreadId() == game_thread_id) {
+        game_thread::attach_current_thread();
+    }
+
+    // handlers only run on the game thread, that is what lets it free replaced handler tables
+    if (!game_thread::is_game_thread()) {
+        engine_process_event(object, function, params);
+        return;
+    }
+
+    if (handler_depth == 0) {
+        process_event::quiescent();
+    }
+
+    // there's no per-frame tick hook, ProcessEvent runs many times a frame and pump() keeps to its budget
+    game_thread::pump();
+    world_snapshot::tick();
+
+    auto handlers = process_event::find(function);
+
+    if (!handlers) [[likely]] {
+        engine_process_event(object, function, params);
+        return;
+    }
+
+    handler_depth++;
+
+    if (process_event::run_pre(*handlers, object, params)) {
+        engine_process_event(object, function, params);
+        process_event::run_post(*handlers, object, params);
+    }
+
+    handler_depth--;
+}
+
+void register_event_handlers() {
+    process_event::before<const SDK::Params::APalPlayerState_EnterChat_Receive_Params>(SDK::EFunctionId::PalPlayerState_EnterChat_Receive, [](const SDK::UObject *, auto *params) {
+        on_chat(params);
+        return true;
+    });
+
+    process_event::before<const SDK::Params::AGameModeBase_K2_OnLogout_Params>(SDK::EFunctionId::GameModeBase_K2_OnLogout, [](const SDK::UObject *, auto *params) {
+        on_logout(params);
+        return true;
+    });
+}
@@ -0,0 +1,151 @@
+#include "process_event_hooks.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace process_event {
+    namespace {
+        // slots per registered function at least, keeps misses on the first probe
+        constexpr size_t MinSlotsPerFunction = 16;
+        constexpr size_t MinSlots            = 64;
+
+        // a published table and the handlers its slots point to
+        struct OwnedTable {
+                detail::Table                          table;
+                std::unique_ptr<detail::Slot[]>        slots;
+                std::vector<std::unique_ptr<Handlers>> handlers;
+        };
+
+        std::unique_ptr<OwnedTable> build_table(const std::unordered_map<const SDK::UFunction *, Handlers> &registered) {
+            auto   owned     = std::make_unique<OwnedTable>();
+            size_t num_slots = std::bit_ceil(std::max(MinSlots, registered.size() * MinSlotsPerFunction));
+
+            owned->slots       = std::make_unique<detail::Slot[]>(num_slots);
+            owned->table.slots = owned->slots.get();
+            owned->table.mask  = num_slots - 1;
+            owned->table.shift = 64 - std::countr_zero(num_slots);
+
+            for (auto &[function, handlers] : registered) {
+                if (handlers.pre.empty() && handlers.post.empty()) {
+                    continue;
+                }
+
+                auto index = detail::slot_index(function, owned->table.shift);
+                while (owned->slots[index].function) {
+                    index = (index + 1) & owned->table.mask;
+                }
+
+                auto &copy = owned->handlers.emplace_back(std::make_unique<Handlers>(handlers));
+                owned->slots[index] = { function, copy.get() };
+            }
+
+            return owned;
+        }
+
+        std::mutex                                           registry_lock;
+        std::unordered_map<const SDK::UFunction *, Handlers> registered;
+        std::unique_ptr<OwnedTable>                          published;
+        std::vector<std::unique_ptr<OwnedTable>>             retired; // replaced, the game thread may still run handlers from them
+        HandlerId                                            next_id = 1;
+
+        // publish - registry_lock held
+        void publish() {
+            if (published) {
+                retired.push_back(std::move(published));
+                detail::has_retired.store(true, std::memory_order_release);
+            }
+
+            published = build_table(registered);
+            detail::current.store(&published->table, std::memory_order_release);
+        }
+
+        const detail::Slot  empty_slots[MinSlots] = {};
+        const detail::Table empty_table { empty_slots, MinSlots - 1, 64 - std::countr_zero(MinSlots) };
+    } // namespace
+
+    namespace detail {
+        std::atomic<const Table *> current     = &empty_table;
+        std::atomic<bool>          has_retired = false;
+
+        void free_retired() {
+            // never blocks the game thread, a registration in progress just moves this to a later call
+            std::unique_lock lock(registry_lock, std::try_to_lock);
+            if (!lock) {
+                return;
+            }
+
+            retired.clear();
+            has_retired.store(false, std::memory_order_relaxed);
+        }
+    } // namespace detail
+
+    HandlerId add_pre(const SDK::UFunction *function, PreHandler handler) {
+        // a null key would read as an empty slot, an unresolved function has nothing to hook anyway
+        if (!function) {
+            return 0;
+        }
+
+        std::lock_guard lock(registry_lock);
+
+        auto id = next_id++;
+        registered[function].pre.emplace_back(id, std::move(handler));
+        publish();
+        return id;
+    }
+
+    HandlerId add_post(const SDK::UFunction *function, PostHandler handler) {
+        // a null key would read as an empty slot, an unresolved function has nothing to hook anyway
+        if (!function) {
+            return 0;
+        }
+
+        std::lock_guard lock(registry_lock);
+
+        auto id = next_id++;
+        registered[function].post.emplace_back(id, std::move(handler));
+        publish();
+        return id;
+    }
+
+    void remove(HandlerId id) {
+        std::lock_guard lock(registry_lock);
+
+        for (auto it = registered.begin(); it != registered.end(); ++it) {
+            auto &[function, handlers] = *it;
+
+            auto removed = std::erase_if(handlers.pre, [id](const auto &item) {
+                return item.first == id;
+            });
+            removed += std::erase_if(handlers.post, [id](const auto &item) {
+                return item.first == id;
+            });
+
+            if (removed) {
+                if (handlers.pre.empty() && handlers.post.empty()) {
+                    registered.erase(it);
+                }
+
+                publish();
+                return;
+            }
+        }
+    }
+
+    bool run_pre(const Handlers &handlers, const SDK::UObject *object, void *params) {
+        for (auto &[id, handler] : handlers.pre) {
+            if (!handler(object, params)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void run_post(const Handlers &handlers, const SDK::UObject *object, void *params) {
+        for (auto &[id, handler] : handlers.post) {
+            handler(object, params);
+        }
+    }
+} // namespace process_event
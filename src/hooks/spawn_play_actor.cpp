@@ -1,7 +1,10 @@
 #include "hooks.h"
 #include "spdlog/spdlog.h"
 #include "engine_functions.h"
+#include "game_fields.h"
+#include "game_functions.h"
 #include "utils.h"
+#include "event_stream.h"
 
 SDK::APlayerController *spawn_play_actor_proxy(SDK::UWorld *that, SDK::UPlayer *player, SDK::ENetRole role, const SDK::FURL *url, const SDK::FUniqueNetIdRepl *uid, SDK::FString *error, uint8_t index) {
     static SDK::UPalUtility *utility = nullptr;
@@ -28,7 +31,7 @@ SDK::APlayerController *spawn_play_actor_proxy(SDK::UWorld *that, SDK::UPlayer *
 
     std::string address = std::string("[UNK]");
 
-    if (controller->NetConnection) {
+    if (controller->NetConnection && LowLevelGetRemoteAddress) {
         auto fsaddress = LowLevelGetRemoteAddress(static_cast<SDK::UIpConnection *>(controller->NetConnection), true);
 
         if (fsaddress && fsaddress->IsValid() && fsaddress->Num() > 1) {
@@ -37,21 +40,32 @@ SDK::APlayerController *spawn_play_actor_proxy(SDK::UWorld *that, SDK::UPlayer *
     }
 
     auto     state    = static_cast<SDK::APalPlayerState *>(state_raw);
-    auto     raw_name = state->GetPlayerName();
+    auto     raw_name = game_functions::get_player_name(state);
     uint32_t pid      = 0;
 
-    if (state->PlayerUId.A != 0) {
-        pid = static_cast<uint32_t>(state->PlayerUId.A);
-    } else if (state->LoginTryingPlayerUId_InServer.A != 0) {
-        pid = static_cast<uint32_t>(state->LoginTryingPlayerUId_InServer.A);
+    auto &player_uid       = APalPlayerState_PlayerUId.Get(state);
+    auto &login_player_uid = APalPlayerState_LoginTryingPlayerUId_InServer.Get(state);
+
+    if (player_uid.A != 0) {
+        pid = static_cast<uint32_t>(player_uid.A);
+    } else if (login_player_uid.A != 0) {
+        pid = static_cast<uint32_t>(login_player_uid.A);
     } else {
-        pid = state->GetPlayerId();
+        pid = game_functions::get_player_id(state);
     }
 
     std::string name = utf16_to_local_codepage(raw_name.Data, raw_name.NumElements);
 
     spdlog::info("[Event::Login] player {} login from {} with id {:08x}, ", name, address, static_cast<uint32_t>(pid));
 
+    events::publish(EventType::Login, [&](JsonWriter &json) {
+        json.key("name");
+        json.value_utf16(raw_name.Data, raw_name.NumElements);
+        json.key("uid");
+        json.value_hex32(pid);
+        json.field("address", address);
+    });
+
     // if we return null, connection will close
 
     return controller;
@@ -0,0 +1,473 @@
+#include "http_api.h"
+#include "event_stream.h"
+#include "game_thread.h"
+#include "json_writer.h"
+#include "metrics.h"
+#include "response_cache.h"
+#include "telemetry.h"
+#include "world_snapshot.h"
+#include "spdlog/spdlog.h"
+
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace {
+    using ResponseFactory = http::response<http::string_body> (*)(const HttpRequest &, http::status, std::string);
+
+    // send_result - answers with a body, a nullopt result is a 404
+    template<typename ResultType>
+    void send_result(const HttpRequest &request, const HttpResponder &responder, ResultType &&result, ResponseFactory make_response) {
+        if constexpr (std::is_same_v<std::decay_t<ResultType>, std::optional<std::string>>) {
+            if (!result) {
+                responder.send(text_response(request, http::status::not_found, "Player not found"));
+                return;
+            }
+
+            responder.send(make_response(request, http::status::ok, std::move(*result)));
+        } else {
+            responder.send(make_response(request, http::status::ok, std::move(result)));
+        }
+    }
+
+    // reply_from_game_thread - runs fn on the game thread and answers with the body it returns
+    template<typename Fn>
+    void reply_from_game_thread(HttpRequest &request, HttpResponder responder, Fn &&fn, ResponseFactory make_response = text_response) {
+        using ResultType = std::invoke_result_t<std::decay_t<Fn>>;
+
+        auto executor = responder.executor();
+
+        game_thread::async_post(std::forward<Fn>(fn), net::bind_executor(executor, [request = std::move(request), responder, make_response](std::exception_ptr error, ResultType result) {
+            if (error) {
+                try {
+                    std::rethrow_exception(error);
+                } catch (std::exception const &e) {
+                    responder.send(text_response(request, http::status::internal_server_error, std::string("Command failed: ") + e.what()));
+                } catch (...) {
+                    responder.send(text_response(request, http::status::internal_server_error, "Command failed"));
+                }
+                return;
+            }
+
+            send_result(request, responder, std::move(result), make_response);
+        }));
+    }
+
+    // EtagBasis - what a body's ETag is computed over, for bodies with fields that change with every snapshot
+    using EtagBasis = std::string (*)(const WorldSnapshot &snapshot);
+
+    // cache_key - route pattern and path parameters, a query string or cache buster doesn't make a new entry
+    std::string cache_key(std::string_view route, const RouteMatch &match) {
+        std::string key(route);
+
+        for (size_t i = 0; i < match.num_params; i++) {
+            key += '\n';
+            key += match.params[i].second;
+        }
+        return key;
+    }
+
+    // reply_from_snapshot - answers JSON rendered from the latest world snapshot without waiting for the game thread.
+    // Bodies are cached per key [cache_key] and snapshot, so polls between two snapshots [or within ttl] are a lookup and a send.
+    // Until the hook publishes snapshots [game thread not attached yet, hooks missing] one is captured through the game thread first.
+    template<typename Fn>
+    void reply_from_snapshot(HttpRequest &request, HttpResponder responder, ResponseCache &cache, std::string_view key, std::chrono::milliseconds ttl, Fn &&render, EtagBasis etag_basis = nullptr) {
+        if (game_thread::is_attached()) {
+            if (auto snapshot = world_snapshot::acquire()) {
+                if (auto cached = cache.find(key, snapshot->sequence, ttl)) {
+                    responder.send(cached_response_writer(request, std::move(cached)));
+                    return;
+                }
+
+                auto result = render(*snapshot);
+
+                if constexpr (std::is_same_v<decltype(result), std::optional<std::string>>) {
+                    if (!result) {
+                        responder.send(text_response(request, http::status::not_found, "Player not found"));
+                        return;
+                    }
+
+                    responder.send(cached_response_writer(request, cache.store(key, snapshot->sequence, std::move(*result), "application/json")));
+                } else {
+                    auto basis = etag_basis ? etag_basis(*snapshot) : std::string();
+                    responder.send(cached_response_writer(request, cache.store(key, snapshot->sequence, std::move(result), "application/json", basis)));
+                }
+                return;
+            }
+        }
+
+        reply_from_game_thread(
+            request, std::move(responder),
+            [render = std::forward<Fn>(render)] {
+                world_snapshot::publish();
+
+                auto snapshot = world_snapshot::acquire();
+                if (!snapshot) {
+                    throw std::runtime_error("no world snapshot");
+                }
+                return render(*snapshot);
+            },
+            json_response);
+    }
+
+    // snapshots already version the cached bodies, the TTLs only bound how long one is reused
+    constexpr auto StateCacheTtl   = std::chrono::milliseconds(1000);
+    constexpr auto PlayersCacheTtl = std::chrono::milliseconds(1000);
+
+    // Commands accepted by one POST /batch, the whole batch runs in a single game thread task
+    constexpr size_t MaxBatchCommands = 256;
+
+    struct BatchCommand {
+            std::string                  text;
+            std::optional<ParsedCommand> parsed;
+            std::string                  reply; // the command's reply, or why it didn't run
+            bool                         ok = false;
+    };
+
+    // parse_batch - one command line per line of the body, blank lines skipped, nullopt past MaxBatchCommands
+    std::optional<std::vector<BatchCommand>> parse_batch(std::string_view body) {
+        std::vector<BatchCommand> commands;
+
+        while (!body.empty()) {
+            auto newline = body.find('\n');
+            auto line    = body.substr(0, newline);
+
+            body = newline == std::string_view::npos ? std::string_view() : body.substr(newline + 1);
+
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            if (line.empty()) {
+                continue;
+            }
+            if (commands.size() == MaxBatchCommands) {
+                return std::nullopt;
+            }
+
+            auto &command  = commands.emplace_back();
+            command.text   = line;
+            command.parsed = parse_command(line, &command.reply);
+        }
+
+        return commands;
+    }
+
+    void write_batch_json(const std::vector<BatchCommand> &commands, JsonWriter &json) {
+        json.begin_object();
+        json.key("results");
+        json.begin_array();
+
+        for (auto &command : commands) {
+            json.begin_object();
+            json.field("command", command.text);
+            json.field("ok", command.ok);
+            json.field(command.ok ? "reply" : "error", command.reply);
+            json.end_object();
+        }
+
+        json.end_array();
+        json.end_object();
+    }
+
+    // Objects written per chunk of GET /objects, each chunk is one game thread task
+    constexpr size_t ObjectsChunkBytes = 16 * 1024;
+
+    // Walks GObjects across chunks, the cursor survives between game thread tasks.
+    // Objects can be destroyed between two chunks, so the dump is a best-effort view, not a consistent snapshot.
+    struct ObjectDump {
+            SDK::UClass *filter = nullptr;
+            int32_t      cursor = 0;
+            int32_t      count  = 0;
+            bool         opened = false;
+
+            // write_chunk - fills chunk up to ObjectsChunkBytes, true once the closing bracket is written
+            bool write_chunk(std::string &chunk) {
+                JsonWriter json(chunk);
+
+                if (!opened) {
+                    opened = true;
+                    json.begin_object();
+                    json.key("objects");
+                    json.begin_array();
+                } else {
+                    json.reset_separator(count == 0);
+                }
+
+                auto                         objects = SDK::UObject::GObjects;
+                SDK::TFixedPathBuffer<1024> name;
+
+                while (cursor < objects->Num() && chunk.size() < ObjectsChunkBytes) {
+                    auto object = objects->GetByIndex(cursor++);
+
+                    if (!object || (filter && !object->IsA(filter))) {
+                        continue;
+                    }
+
+                    name.Reset();
+                    object->AppendFullName(name);
+
+                    json.begin_object();
+                    json.field("index", object->Index);
+                    json.field("name", name.View());
+                    json.end_object();
+                    count++;
+                }
+
+                if (cursor < objects->Num()) {
+                    return false;
+                }
+
+                json.end_array();
+                json.field("count", count);
+                json.end_object();
+                return true;
+            }
+    };
+} // namespace
+
+void register_http_routes(HttpRouter &router, std::shared_ptr<SDKContext> sdkContext) {
+    auto cache = std::make_shared<ResponseCache>();
+
+    router.add(http::verb::get, "/world/state", [cache](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        auto render = [](const WorldSnapshot &snapshot) {
+            std::string body;
+            JsonWriter  json(body);
+            world_snapshot::write_state_json(snapshot, json);
+            return body;
+        };
+
+        // the frame time and snapshot fields change every snapshot, a poller only refetches when a count changed
+        auto etag_basis = [](const WorldSnapshot &snapshot) {
+            std::string body;
+            JsonWriter  json(body);
+            world_snapshot::write_state_json(snapshot, json, false);
+            return body;
+        };
+
+        reply_from_snapshot(request, std::move(responder), *cache, cache_key("/world/state", match), StateCacheTtl, render, etag_basis);
+    });
+
+    router.add(http::verb::get, "/metrics", [](HttpRequest &request, const RouteMatch &, HttpResponder responder) {
+        std::string body;
+        metrics::write_prometheus(body);
+
+        auto response = text_response(request, http::status::ok, std::move(body));
+        response.set(http::field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+        responder.send(std::move(response));
+    });
+
+    router.add(http::verb::get, "/telemetry", [](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        std::optional<uint64_t> base;
+
+        if (auto raw = match.query.raw("base")) {
+            uint64_t sequence = 0;
+            auto [end, ec]    = std::from_chars(raw->data(), raw->data() + raw->size(), sequence);
+
+            if (ec != std::errc() || end != raw->data() + raw->size()) {
+                responder.send(text_response(request, http::status::bad_request, "Bad Request: 'base' is not a sequence number"));
+                return;
+            }
+            base = sequence;
+        }
+
+        if (game_thread::is_attached()) {
+            if (auto snapshot = world_snapshot::acquire()) {
+                responder.send(binary_response(request, http::status::ok, telemetry::write_frame(*snapshot, base)));
+                return;
+            }
+        }
+
+        reply_from_game_thread(
+            request, std::move(responder),
+            [base] {
+                world_snapshot::publish();
+
+                auto snapshot = world_snapshot::acquire();
+                if (!snapshot) {
+                    throw std::runtime_error("no world snapshot");
+                }
+                return telemetry::write_frame(*snapshot, base);
+            },
+            binary_response);
+    });
+
+    router.add(http::verb::post, "/world/broadcast", RequestCost::write, [sdkContext](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        auto message = match.query.get("message");
+        if (!message || message->empty()) {
+            responder.send(text_response(request, http::status::bad_request, "Bad Request: missing 'message' parameter"));
+            return;
+        }
+
+        reply_from_game_thread(request, std::move(responder), [sdkContext, message = std::move(*message)] {
+            return command_broadcast(*sdkContext, message);
+        });
+    });
+
+    router.add(http::verb::post, "/world/gc", RequestCost::write, [sdkContext](HttpRequest &request, const RouteMatch &, HttpResponder responder) {
+        reply_from_game_thread(request, std::move(responder), [sdkContext] {
+            return command_gc(*sdkContext);
+        });
+    });
+
+    router.add(http::verb::get, "/players", [cache](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        reply_from_snapshot(request, std::move(responder), *cache, cache_key("/players", match), PlayersCacheTtl, [](const WorldSnapshot &snapshot) {
+            std::string body;
+            JsonWriter  json(body);
+            world_snapshot::write_players_json(snapshot, json);
+            return body;
+        });
+    });
+
+    router.add(http::verb::get, "/players/{uid}", [cache](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        reply_from_snapshot(request, std::move(responder), *cache, cache_key("/players/{uid}", match), PlayersCacheTtl, [uid = std::string(match.param("uid"))](const WorldSnapshot &snapshot) -> std::optional<std::string> {
+            auto player = snapshot.find_player(uid);
+            if (!player) {
+                return std::nullopt;
+            }
+
+            std::string body;
+            JsonWriter  json(body);
+            world_snapshot::write_player_json(*player, json);
+            return body;
+        });
+    });
+
+    router.add(http::verb::post, "/players/{uid}/kick", RequestCost::write, [sdkContext](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        reply_from_game_thread(request, std::move(responder), [sdkContext, uid = std::string(match.param("uid"))] {
+            return command_kick(*sdkContext, uid);
+        });
+    });
+
+    router.add(http::verb::get, "/objects", RequestCost::write, [](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        auto class_name = match.query.get("class").value_or(std::string());
+        auto executor   = responder.executor();
+
+        // the class lookup reads object names, so it runs on the game thread like the dump itself
+        game_thread::async_post(
+            [class_name = std::move(class_name)]() -> std::optional<SDK::UClass *> {
+                if (class_name.empty()) {
+                    return nullptr;
+                }
+
+                if (auto filter = SDK::UObject::FindClassFast(class_name)) {
+                    return filter;
+                }
+                return std::nullopt;
+            },
+            net::bind_executor(executor, [request = std::move(request), responder](std::exception_ptr error, std::optional<SDK::UClass *> filter) {
+                if (error || !filter) {
+                    responder.send(text_response(request, http::status::not_found, "Class not found"));
+                    return;
+                }
+
+                auto dump    = std::make_shared<ObjectDump>();
+                dump->filter = *filter;
+
+                responder.send(std::make_unique<HttpChunkedWriter>(
+                    stream_header(request, "application/json"),
+                    [dump](std::string &chunk, std::function<void(bool)> next) {
+                        game_thread::run_or_enqueue([dump, &chunk, next = std::move(next)] {
+                            next(dump->write_chunk(chunk));
+                        });
+                    },
+                    accepted_coding(request)));
+            }));
+    });
+
+    router.add(http::verb::get, "/events", [](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        if (!beast::websocket::is_upgrade(request)) {
+            responder.send(text_response(request, http::status::upgrade_required, "WebSocket upgrade required"));
+            return;
+        }
+
+        auto type_mask = std::optional<uint32_t>(AllEventTypes);
+
+        if (auto types = match.query.get("types"); types && !types->empty()) {
+            type_mask = parse_event_types(*types);
+
+            if (!type_mask) {
+                responder.send(text_response(request, http::status::bad_request, "Bad Request: unknown event type"));
+                return;
+            }
+        }
+
+        responder.send(std::make_unique<HttpUpgradeWriter>(std::move(request), [type_mask = *type_mask](tcp::socket &&socket, HttpRequest &&upgrade_request) {
+            events::accept_subscriber(std::move(socket), std::move(upgrade_request), type_mask);
+        }));
+    });
+
+    router.add(http::verb::post, "/batch", RequestCost::write, [sdkContext](HttpRequest &request, const RouteMatch &, HttpResponder responder) {
+        // parsed and validated here, the game thread only runs what is left
+        auto commands = parse_batch(request.body());
+        if (!commands) {
+            responder.send(text_response(request, http::status::payload_too_large, fmt::format("Payload Too Large: at most {} commands per batch", MaxBatchCommands)));
+            return;
+        }
+        if (commands->empty()) {
+            responder.send(text_response(request, http::status::bad_request, "Bad Request: no commands, one command line per line"));
+            return;
+        }
+
+        // a batch no bucket can ever hold would otherwise get 429 forever
+        if (static_cast<double>(commands->size()) > admission::max_tokens(RequestCost::write)) {
+            responder.send(text_response(request, http::status::payload_too_large, fmt::format("Payload Too Large: at most {} commands per batch", admission::max_tokens(RequestCost::write))));
+            return;
+        }
+
+        // the router took a token for the request and its game thread task, every further command pays its client token
+        if (commands->size() > 1) {
+            if (auto admission = admission::admit(responder.client_address(), api_token(request), RequestCost::write, static_cast<double>(commands->size() - 1), false); !admission) {
+                responder.send(refused_response(request, admission));
+                return;
+            }
+        }
+
+        auto executor = responder.executor();
+
+        game_thread::async_post(
+            [sdkContext, commands = std::move(*commands)]() mutable {
+                // one UID lookup for every kick of the batch
+                PlayerIndex players(*sdkContext);
+
+                for (auto &command : commands) {
+                    if (!command.parsed) {
+                        continue;
+                    }
+
+                    try {
+                        command.reply = run_command(*command.parsed, *sdkContext, players);
+                        command.ok    = true;
+                    } catch (std::exception const &e) {
+                        command.reply = std::string("Command failed: ") + e.what();
+                    }
+                }
+                return std::move(commands);
+            },
+            net::bind_executor(executor, [request = std::move(request), responder](std::exception_ptr error, std::vector<BatchCommand> commands) {
+                if (error) {
+                    responder.send(text_response(request, http::status::internal_server_error, "Command failed"));
+                    return;
+                }
+
+                std::string body;
+                JsonWriter  json(body);
+                write_batch_json(commands, json);
+                responder.send(json_response(request, http::status::ok, std::move(body)));
+            }));
+    });
+
+    router.add(http::verb::get, "/rcon", RequestCost::write, [sdkContext](HttpRequest &request, const RouteMatch &match, HttpResponder responder) {
+        auto text = match.query.get("text");
+        if (!text || text->empty()) {
+            responder.send(text_response(request, http::status::bad_request, "Bad Request: missing 'text' parameter"));
+            return;
+        }
+
+        reply_from_game_thread(request, std::move(responder), [sdkContext, text = std::move(*text)] {
+            return execute_command(text, *sdkContext);
+        });
+    });
+}
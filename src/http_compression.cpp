@@ -0,0 +1,270 @@
+#include "http_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <stdexcept>
+#include <vector>
+
+namespace zlib = boost::beast::zlib;
+
+namespace {
+    std::atomic<size_t> min_body_bytes { 1024 };
+    std::atomic<int>    compression_level { 4 };
+
+    // deflate states kept per I/O thread, each holds a few hundred KB of window and hash tables once used
+    constexpr size_t StreamsPerThread = 4;
+
+    thread_local std::vector<std::unique_ptr<zlib::deflate_stream>> stream_pool;
+
+    constexpr std::array<uint32_t, 256> crc_table = [] {
+        std::array<uint32_t, 256> table {};
+
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return table;
+    }();
+
+    uint32_t crc32(uint32_t crc, std::string_view data) {
+        crc = ~crc;
+        for (unsigned char c : data) {
+            crc = crc_table[(crc ^ c) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    uint32_t adler32(uint32_t adler, std::string_view data) {
+        // 5552 bytes is the most that can be summed before the 32 bit sums have to be reduced
+        uint32_t a = adler & 0xffff;
+        uint32_t b = adler >> 16;
+
+        while (!data.empty()) {
+            auto block = std::min<size_t>(data.size(), 5552);
+
+            for (unsigned char c : data.substr(0, block)) {
+                a += c;
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+
+            data.remove_prefix(block);
+        }
+        return (b << 16) | a;
+    }
+
+    void append_le32(std::string &out, uint32_t value) {
+        for (int i = 0; i < 4; i++) {
+            out += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    void append_be32(std::string &out, uint32_t value) {
+        for (int i = 3; i >= 0; i--) {
+            out += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    bool iequals(std::string_view a, std::string_view b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+            return (x | 0x20) == (y | 0x20);
+        });
+    }
+
+    // parse_quality - "q=0.5" in thousandths, 1000 when there is no q parameter
+    int parse_quality(std::string_view params) {
+        while (!params.empty()) {
+            auto semicolon = params.find(';');
+            auto param     = trim(params.substr(0, semicolon));
+
+            params = semicolon == std::string_view::npos ? std::string_view() : params.substr(semicolon + 1);
+
+            if (param.size() < 2 || (param[0] | 0x20) != 'q' || param[1] != '=') {
+                continue;
+            }
+
+            double value = 0;
+            auto   text  = param.substr(2);
+            auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+            if (ec != std::errc()) {
+                return 0;
+            }
+            return static_cast<int>(std::clamp(value, 0.0, 1.0) * 1000);
+        }
+        return 1000;
+    }
+} // namespace
+
+namespace http_compression {
+    void configure(size_t min_bytes, int level) {
+        min_body_bytes.store(min_bytes, std::memory_order_relaxed);
+        compression_level.store(std::clamp(level, 1, 9), std::memory_order_relaxed);
+    }
+
+    size_t min_bytes() {
+        return min_body_bytes.load(std::memory_order_relaxed);
+    }
+
+    ContentCoding negotiate(std::string_view accept_encoding) {
+        int gzip     = -1;
+        int deflate  = -1;
+        int wildcard = -1;
+
+        while (!accept_encoding.empty()) {
+            auto comma = accept_encoding.find(',');
+            auto item  = accept_encoding.substr(0, comma);
+
+            accept_encoding = comma == std::string_view::npos ? std::string_view() : accept_encoding.substr(comma + 1);
+
+            auto semicolon = item.find(';');
+            auto token     = trim(item.substr(0, semicolon));
+            auto quality   = semicolon == std::string_view::npos ? 1000 : parse_quality(item.substr(semicolon + 1));
+
+            if (iequals(token, "gzip") || iequals(token, "x-gzip")) {
+                gzip = quality;
+            } else if (iequals(token, "deflate")) {
+                deflate = quality;
+            } else if (token == "*") {
+                wildcard = quality;
+            }
+        }
+
+        // "*" stands for every coding not listed by name
+        if (gzip < 0) {
+            gzip = wildcard;
+        }
+        if (deflate < 0) {
+            deflate = wildcard;
+        }
+
+        if (gzip > 0 && gzip >= deflate) {
+            return ContentCoding::gzip;
+        }
+        if (deflate > 0) {
+            return ContentCoding::deflate;
+        }
+        return ContentCoding::identity;
+    }
+
+    std::string_view name(ContentCoding coding) {
+        switch (coding) {
+            case ContentCoding::gzip:
+                return "gzip";
+            case ContentCoding::deflate:
+                return "deflate";
+            default:
+                return {};
+        }
+    }
+
+    std::string compress(std::string_view body, ContentCoding coding) {
+        std::string out;
+
+        if (coding == ContentCoding::identity) {
+            out = body;
+            return out;
+        }
+
+        StreamCompressor compressor(coding);
+        compressor.write(body, out, true);
+        return out;
+    }
+} // namespace http_compression
+
+StreamCompressor::StreamCompressor(ContentCoding in_coding) : coding(in_coding) {
+    if (!stream_pool.empty()) {
+        stream = std::move(stream_pool.back());
+        stream_pool.pop_back();
+    } else {
+        stream = std::make_unique<zlib::deflate_stream>();
+    }
+
+    // a reset keeps the buffers of the last use, only the first stream of a thread allocates
+    stream->reset(compression_level.load(std::memory_order_relaxed), 15, 8, zlib::Strategy::normal);
+
+    checksum = coding == ContentCoding::deflate ? 1 : 0;
+}
+
+StreamCompressor::~StreamCompressor() {
+    if (stream_pool.size() < StreamsPerThread) {
+        stream_pool.push_back(std::move(stream));
+    }
+}
+
+void StreamCompressor::write(std::string_view input, std::string &out, bool finish) {
+    if (!started) {
+        started = true;
+
+        if (coding == ContentCoding::gzip) {
+            // magic, deflate, no flags, no mtime, no extra flags, unknown OS
+            out.append("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+        } else {
+            // 32K window, (0x78 * 256 + 0x9c) % 31 == 0
+            out.append("\x78\x9c", 2);
+        }
+    }
+
+    if (coding == ContentCoding::gzip) {
+        checksum = crc32(checksum, input);
+        size += static_cast<uint32_t>(input.size());
+    } else {
+        checksum = adler32(checksum, input);
+    }
+
+    zlib::z_params zs;
+    zs.next_in  = input.data();
+    zs.avail_in = input.size();
+
+    auto flush = finish ? zlib::Flush::finish : zlib::Flush::sync;
+
+    for (;;) {
+        auto offset = out.size();
+        out.resize(offset + stream->upper_bound(zs.avail_in) + 16);
+
+        zs.next_out  = out.data() + offset;
+        zs.avail_out = out.size() - offset;
+
+        boost::beast::error_code ec;
+        stream->write(zs, flush, ec);
+
+        out.resize(out.size() - zs.avail_out);
+
+        if (ec == zlib::error::end_of_stream) {
+            break;
+        }
+        if (ec && ec != zlib::error::need_buffers) {
+            throw std::runtime_error("deflate failed: " + ec.message());
+        }
+
+        // a flush is complete once it stops filling the whole output buffer
+        if (!finish && zs.avail_in == 0 && (zs.avail_out != 0 || ec == zlib::error::need_buffers)) {
+            break;
+        }
+    }
+
+    if (finish) {
+        if (coding == ContentCoding::gzip) {
+            append_le32(out, checksum);
+            append_le32(out, size);
+        } else {
+            append_be32(out, checksum);
+        }
+    }
+}
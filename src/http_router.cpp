@@ -0,0 +1,206 @@
+#include "http_router.h"
+
+namespace {
+    constexpr const char *RequestDurationName = "pal_http_request_duration_seconds";
+    constexpr const char *RequestDurationHelp = "Time from reading an HTTP request to handing over its response, by route.";
+
+    LatencyHistogram &route_latency(std::string_view method, std::string_view route) {
+        return metrics::histogram(RequestDurationName, RequestDurationHelp, metrics::label("method", method) + "," + metrics::label("route", route));
+    }
+
+    int hex_value(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    // next_segment - pops the next "/"-separated segment off path
+    std::string_view next_segment(std::string_view &path) {
+        while (!path.empty() && path.front() == '/') {
+            path.remove_prefix(1);
+        }
+
+        auto end     = path.find('/');
+        auto segment = path.substr(0, end);
+
+        path.remove_prefix(end == std::string_view::npos ? path.size() : end);
+        return segment;
+    }
+} // namespace
+
+std::optional<std::string_view> QueryString::raw(std::string_view key) const {
+    std::string_view rest = query;
+
+    while (!rest.empty()) {
+        auto end  = rest.find('&');
+        auto pair = rest.substr(0, end);
+
+        rest.remove_prefix(end == std::string_view::npos ? rest.size() : end + 1);
+
+        auto separator = pair.find('=');
+        auto name      = pair.substr(0, separator);
+
+        if (name == key) {
+            return separator == std::string_view::npos ? std::string_view() : pair.substr(separator + 1);
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<std::string> QueryString::get(std::string_view key) const {
+    auto value = raw(key);
+    if (!value) {
+        return std::nullopt;
+    }
+
+    return decode(*value);
+}
+
+std::string QueryString::decode(std::string_view value) {
+    std::string result;
+    result.reserve(value.size());
+
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '+') {
+            result += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size() && hex_value(value[i + 1]) >= 0 && hex_value(value[i + 2]) >= 0) {
+            result += static_cast<char>(hex_value(value[i + 1]) << 4 | hex_value(value[i + 2]));
+            i += 2;
+        } else {
+            result += value[i];
+        }
+    }
+
+    return result;
+}
+
+HttpRouter::HttpRouter() : nodes(1), unmatched_latency(&route_latency("", "")) {}
+
+std::string_view api_token(const HttpRequest &request) {
+    auto token = request[http::field::authorization];
+
+    // "Bearer <token>" or the bare token
+    if (token.starts_with("Bearer ")) {
+        token.remove_prefix(7);
+    }
+
+    return std::string_view(token.data(), token.size());
+}
+
+http::response<http::string_body> refused_response(const HttpRequest &request, const Admission &admission) {
+    if (admission.never) {
+        return text_response(request, http::status::payload_too_large, "Payload Too Large: more than the rate limit ever allows");
+    }
+
+    return too_many_requests(request, admission.retry_after);
+}
+
+void HttpRouter::add(http::verb method, std::string_view pattern, RequestCost cost, RouteHandler handler) {
+    auto  method_name = http::to_string(method);
+    auto &latency     = route_latency(std::string_view(method_name.data(), method_name.size()), pattern);
+
+    size_t node = 0;
+
+    for (auto segment = next_segment(pattern); !segment.empty(); segment = next_segment(pattern)) {
+        if (segment.size() > 2 && segment.front() == '{' && segment.back() == '}') {
+            if (!nodes[node].param_child) {
+                nodes[node].param_child = nodes.size();
+                nodes[node].param_name  = segment.substr(1, segment.size() - 2);
+                nodes.emplace_back();
+            }
+
+            node = nodes[node].param_child;
+            continue;
+        }
+
+        size_t child = 0;
+        for (auto &[name, index] : nodes[node].children) {
+            if (name == segment) {
+                child = index;
+                break;
+            }
+        }
+
+        if (!child) {
+            child = nodes.size();
+            nodes[node].children.emplace_back(std::string(segment), child);
+            nodes.emplace_back();
+        }
+
+        node = child;
+    }
+
+    nodes[node].handlers.push_back({ method, std::move(handler), &latency, cost });
+}
+
+const HttpRouter::Node *HttpRouter::find(std::string_view path, RouteMatch &match) const {
+    size_t node = 0;
+
+    for (auto segment = next_segment(path); !segment.empty(); segment = next_segment(path)) {
+        size_t child = 0;
+
+        for (auto &[name, index] : nodes[node].children) {
+            if (name == segment) {
+                child = index;
+                break;
+            }
+        }
+
+        if (!child && nodes[node].param_child && match.num_params < RouteMatch::max_params) {
+            child                            = nodes[node].param_child;
+            match.params[match.num_params++] = { nodes[node].param_name, segment };
+        }
+
+        if (!child) {
+            return nullptr;
+        }
+
+        node = child;
+    }
+
+    return &nodes[node];
+}
+
+void HttpRouter::dispatch(HttpRequest &&request, HttpResponder responder) const {
+    std::string_view target(request.target().data(), request.target().size());
+    RouteMatch       match;
+
+    auto query_start = target.find('?');
+    if (query_start != std::string_view::npos) {
+        match.query = QueryString(target.substr(query_start + 1));
+        target      = target.substr(0, query_start);
+    }
+
+    const Node *node = find(target, match);
+
+    if (!node || node->handlers.empty()) {
+        responder.observe(*unmatched_latency);
+        responder.send(text_response(request, http::status::not_found, "Not Found"));
+        return;
+    }
+
+    for (auto &route : node->handlers) {
+        if (route.method == request.method()) {
+            responder.observe(*route.latency);
+
+            if (auto admission = admission::admit(responder.client_address(), api_token(request), route.cost); !admission) {
+                responder.send(refused_response(request, admission));
+                return;
+            }
+
+            route.handler(request, match, std::move(responder));
+            return;
+        }
+    }
+
+    responder.observe(*unmatched_latency);
+    responder.send(text_response(request, http::status::method_not_allowed, "Method Not Allowed"));
+}
@@ -0,0 +1,625 @@
+#include "http_server.h"
+#include "spdlog/spdlog.h"
+
+#include <deque>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // What the session needs beyond reading and writing, per stream type
+
+    template<class Protocol>
+    void set_deadline(beast::basic_stream<Protocol> &stream, std::chrono::seconds timeout) {
+        stream.expires_after(timeout);
+    }
+
+    template<class Protocol>
+    void clear_deadline(beast::basic_stream<Protocol> &stream) {
+        stream.expires_never();
+    }
+
+    template<class Protocol>
+    void cancel_io(beast::basic_stream<Protocol> &stream) {
+        stream.socket().cancel();
+    }
+
+    template<class Protocol>
+    void close_stream(beast::basic_stream<Protocol> &stream) {
+        beast::error_code ec;
+        stream.socket().shutdown(Protocol::socket::shutdown_send, ec);
+        stream.socket().close(ec);
+    }
+
+    // peer_address - the client's address without the port, every local connection is "local"
+    std::string peer_address(beast::tcp_stream &stream) {
+        beast::error_code ec;
+        auto              endpoint = stream.socket().remote_endpoint(ec);
+
+        return ec ? std::string("[UNK]") : endpoint.address().to_string();
+    }
+
+    template<class Stream>
+    std::string peer_address(Stream &) {
+        return "local";
+    }
+
+#ifdef _WIN32
+    // pipe clients are on this host, a pipe has no deadline and stays open until the client goes away
+    void set_deadline(net::windows::stream_handle &, std::chrono::seconds) {}
+    void clear_deadline(net::windows::stream_handle &) {}
+
+    void cancel_io(net::windows::stream_handle &stream) {
+        beast::error_code ec;
+        stream.cancel(ec);
+    }
+
+    void close_stream(net::windows::stream_handle &stream) {
+        beast::error_code ec;
+        stream.close(ec);
+    }
+#endif
+} // namespace
+
+template<class Stream>
+class HttpStreamSession : public HttpSession, public std::enable_shared_from_this<HttpStreamSession<Stream>> {
+    public:
+        template<class Socket>
+        HttpStreamSession(Socket &&socket, const HttpServerOptions &in_options, const HttpHandler &in_handler)
+            : stream(std::move(socket)), address(peer_address(stream)), options(in_options), handler(in_handler) {
+            metrics::http_connections.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~HttpStreamSession() {
+            metrics::http_connections.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void start() {
+            net::dispatch(stream.get_executor(), beast::bind_front_handler(&HttpStreamSession::do_read, this->shared_from_this()));
+        }
+
+        net::any_io_executor executor() override {
+            return stream.get_executor();
+        }
+
+        const std::string &client_address() const override {
+            return address;
+        }
+
+        void fulfill(uint64_t slot, std::unique_ptr<HttpResponseWriter> writer) override {
+            net::dispatch(stream.get_executor(), [self = this->shared_from_this(), slot, writer = std::shared_ptr<HttpResponseWriter>(std::move(writer))]() mutable {
+                self->on_fulfill(slot, std::move(writer));
+            });
+        }
+
+    private:
+        struct Pending {
+                uint64_t                            slot;
+                std::shared_ptr<HttpResponseWriter> writer;
+        };
+
+        void do_read() {
+            // pipelined requests are read ahead until this many responses are waiting
+            if (pending.size() >= options.pipeline_limit) {
+                read_paused = true;
+                return;
+            }
+
+            read_paused = false;
+            reading     = true;
+
+            parser.emplace();
+            parser->body_limit(1024 * 1024);
+
+            // a pending read keeps its deadline, one set now would cut off a response that is still streaming.
+            // Reading ahead of a response waits without one, on_write re-arms the read once every response is out.
+            read_unbounded = !pending.empty();
+
+            if (read_unbounded) {
+                clear_deadline(stream);
+            } else {
+                set_deadline(stream, options.idle_timeout);
+            }
+
+            http::async_read(stream, buffer, *parser, beast::bind_front_handler(&HttpStreamSession::on_read, this->shared_from_this()));
+        }
+
+        void on_read(beast::error_code ec, std::size_t) {
+            reading = false;
+
+            if (ec == net::error::operation_aborted && rearming_read && !closing) {
+                rearming_read = false;
+                do_read();
+                return;
+            }
+
+            if (ec) {
+                if (ec != http::error::end_of_stream && ec != beast::error::timeout && ec != net::error::operation_aborted) {
+                    spdlog::debug("Error reading HTTP request: {}", ec.message());
+                    metrics::http_read_errors.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                // let queued responses go out, the connection closes after them
+                closing = true;
+                if (pending.empty()) {
+                    do_close();
+                }
+                return;
+            }
+
+            HttpRequest request    = parser->release();
+            bool        keep_alive = request.keep_alive();
+            bool        upgrade    = beast::websocket::is_upgrade(request);
+            uint64_t    slot       = next_slot++;
+
+            pending.push_back({ slot, nullptr });
+
+            try {
+                handler(std::move(request), HttpResponder(this->shared_from_this(), slot));
+            } catch (std::exception const &e) {
+                spdlog::error("HTTP handler failed: {}", e.what());
+                metrics::http_handler_errors.fetch_add(1, std::memory_order_relaxed);
+
+                http::response<http::string_body> response { http::status::internal_server_error, 11 };
+                response.set(http::field::content_type, "text/plain");
+                response.keep_alive(false);
+                response.body() = "Internal Server Error";
+                response.prepare_payload();
+
+                on_fulfill(slot, std::make_shared<HttpMessageWriter<http::string_body>>(std::move(response)));
+            }
+
+            // nothing after an upgrade request is HTTP, the socket may be handed over [HttpUpgradeWriter]
+            if (!keep_alive || upgrade) {
+                closing = true;
+                return;
+            }
+
+            if (!closing) {
+                do_read();
+            }
+        }
+
+        void on_fulfill(uint64_t slot, std::shared_ptr<HttpResponseWriter> writer) {
+            for (auto &entry : pending) {
+                if (entry.slot == slot) {
+                    if (!entry.writer) {
+                        entry.writer = std::move(writer);
+                    }
+                    break;
+                }
+            }
+
+            do_write();
+        }
+
+        void do_write() {
+            if (writing || pending.empty() || !pending.front().writer) {
+                return;
+            }
+
+            writing = true;
+
+            // writes have their own deadline, an idle read timer must not cut a slow client off mid response
+            set_deadline(stream, options.idle_timeout);
+
+            pending.front().writer->write_timeout = options.idle_timeout;
+            pending.front().writer->async_write(stream, beast::bind_front_handler(&HttpStreamSession::on_write, this->shared_from_this()));
+        }
+
+        void on_write(beast::error_code ec) {
+            writing = false;
+
+            if (ec) {
+                spdlog::debug("Error writing HTTP response: {}", ec.message());
+                metrics::http_write_errors.fetch_add(1, std::memory_order_relaxed);
+
+                // the writers hold completion handlers that hold this session
+                pending.clear();
+                do_close();
+                return;
+            }
+
+            bool keep_alive = pending.front().writer->keep_alive();
+            pending.pop_front();
+
+            if (!keep_alive || (closing && pending.empty())) {
+                do_close();
+                return;
+            }
+
+            do_write();
+
+            if (read_paused && !closing) {
+                do_read();
+            }
+
+            // the connection is idle now, restart a read waiting without a deadline if it hasn't started on a request
+            if (pending.empty() && reading && read_unbounded && !parser->got_some() && !closing) {
+                rearming_read = true;
+                cancel_io(stream);
+            }
+        }
+
+        void do_close() {
+            if (reading) {
+                // the pending read completes with an error and comes back here
+                closing = true;
+                cancel_io(stream);
+                return;
+            }
+
+            close_stream(stream);
+        }
+
+        Stream                                                 stream;
+        std::string                                            address;
+        beast::flat_buffer                                     buffer;
+        const HttpServerOptions                               &options;
+        const HttpHandler                                     &handler;
+        std::optional<http::request_parser<http::string_body>> parser;
+        std::deque<Pending>                                    pending;
+        uint64_t                                               next_slot      = 0;
+        bool                                                   reading        = false;
+        bool                                                   read_paused    = false;
+        bool                                                   writing        = false;
+        bool                                                   closing        = false;
+        bool                                                   read_unbounded = false; // the pending read has no deadline
+        bool                                                   rearming_read  = false; // on_write cancelled it to set one
+};
+
+void HttpChunkedWriter::async_write(beast::tcp_stream &in_stream, Done in_done) {
+    stream = &in_stream;
+    done   = std::move(in_done);
+
+    next_chunk();
+}
+
+void HttpChunkedWriter::async_write(LocalStream &in_stream, Done in_done) {
+    stream = &in_stream;
+    done   = std::move(in_done);
+
+    next_chunk();
+}
+
+void HttpChunkedWriter::next_chunk() {
+    chunk.clear();
+
+    // the session keeps this writer alive until done() is called
+    produce(chunk, [this](bool finished) {
+        auto executor = std::visit([](auto *out) -> net::any_io_executor { return out->get_executor(); }, stream);
+
+        net::dispatch(executor, [this, finished] {
+            write_chunk(finished);
+        });
+    });
+}
+
+void HttpChunkedWriter::finish(beast::error_code ec) {
+    // done usually ends up destroying this writer [the session pops it], it must not run from the member
+    auto handler = std::move(done);
+    handler(ec);
+}
+
+void HttpChunkedWriter::write_chunk(bool finished) {
+    if (!serializer) {
+        // the first chunk decides the coding, a body that is done before the threshold isn't worth compressing
+        if (coding != ContentCoding::identity) {
+            header.set(http::field::vary, "Accept-Encoding");
+
+            if (!finished || chunk.size() >= http_compression::min_bytes()) {
+                auto name = http_compression::name(coding);
+                header.set(http::field::content_encoding, beast::string_view(name.data(), name.size()));
+                compressor.emplace(coding);
+            }
+        }
+
+        serializer.emplace(header);
+
+        auto after_header = [this, finished](beast::error_code ec, std::size_t bytes) {
+            metrics::http_bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+
+            if (ec) {
+                finish(ec);
+                return;
+            }
+
+            write_chunk(finished);
+        };
+
+        std::visit([&](auto *out) { http::async_write_header(*out, *serializer, std::move(after_header)); }, stream);
+        return;
+    }
+
+    auto after_write = [this, finished](beast::error_code ec, std::size_t bytes) {
+        metrics::http_bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+
+        if (ec) {
+            finish(ec);
+            return;
+        }
+
+        if (finished) {
+            auto after_last = [this](beast::error_code ec, std::size_t bytes) {
+                metrics::http_bytes_sent.fetch_add(bytes, std::memory_order_relaxed);
+                finish(ec);
+            };
+
+            if (!header.chunked()) {
+                finish({});
+                return;
+            }
+
+            std::visit([&](auto *out) {
+                set_deadline(*out, write_timeout);
+                net::async_write(*out, http::make_chunk_last(), std::move(after_last));
+            }, stream);
+            return;
+        }
+
+        next_chunk();
+    };
+
+    auto *body = &chunk;
+
+    if (compressor && (finished || !chunk.empty())) {
+        encoded.clear();
+        compressor->write(chunk, encoded, finished);
+        body = &encoded;
+    }
+
+    if (body->empty()) {
+        after_write({}, 0);
+        return;
+    }
+
+    // the session's deadline covers one write, a stream that keeps producing must not run into it
+    std::visit([&](auto *out) {
+        set_deadline(*out, write_timeout);
+
+        if (header.chunked()) {
+            net::async_write(*out, http::make_chunk(net::buffer(*body)), std::move(after_write));
+        } else {
+            net::async_write(*out, net::buffer(*body), std::move(after_write));
+        }
+    }, stream);
+}
+
+void HttpUpgradeWriter::async_write(LocalStream &stream, Done done) {
+    auto response = text_response(request, http::status::not_implemented, "Not Implemented: WebSocket is only served over TCP");
+    response.keep_alive(false);
+
+    refusal = std::make_unique<HttpMessageWriter<http::string_body>>(std::move(response));
+    refusal->async_write(stream, std::move(done));
+}
+
+void HttpResponder::send(std::unique_ptr<HttpResponseWriter> writer) const {
+    if (latency) {
+        latency->record(std::chrono::steady_clock::now() - received);
+    }
+
+    session->fulfill(slot, std::move(writer));
+}
+
+net::any_io_executor HttpResponder::executor() const {
+    return session->executor();
+}
+
+const std::string &HttpResponder::client_address() const {
+    return session->client_address();
+}
+
+HttpServer::HttpServer(HttpServerOptions in_options, HttpHandler in_handler)
+    : options(std::move(in_options)), handler(std::move(in_handler)), ioc(std::max(1, options.threads)), acceptor(net::make_strand(ioc)) {}
+
+HttpServer::~HttpServer() {
+    stop();
+}
+
+void HttpServer::start() {
+    tcp::endpoint endpoint { net::ip::make_address(options.address), options.port };
+
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(net::socket_base::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen(net::socket_base::max_listen_connections);
+
+    do_accept();
+
+    if (!options.local_path.empty()) {
+        start_local();
+    }
+
+    int num_threads = std::max(1, options.threads);
+    threads.reserve(num_threads);
+
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([this] {
+            ioc.run();
+        });
+    }
+
+    spdlog::info("HTTP server is running at {}:{} ({} threads) ...", options.address, options.port, num_threads);
+}
+
+void HttpServer::stop() {
+    ioc.stop();
+
+    for (auto &thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads.clear();
+
+#ifndef _WIN32
+    if (local_acceptor) {
+        beast::error_code ec;
+        local_acceptor->close(ec);
+        local_acceptor.reset();
+        ::unlink(options.local_path.c_str());
+    }
+#endif
+}
+
+void HttpServer::do_accept() {
+    // every connection gets its own strand, so a session never needs a lock
+    acceptor.async_accept(net::make_strand(ioc), [this](beast::error_code ec, tcp::socket socket) {
+        if (!ec) {
+            socket.set_option(tcp::no_delay(true), ec);
+            std::make_shared<HttpStreamSession<beast::tcp_stream>>(std::move(socket), options, handler)->start();
+        } else {
+            spdlog::error("Error accepting connection: {}", ec.message());
+        }
+
+        do_accept();
+    });
+}
+
+#ifdef _WIN32
+void HttpServer::start_local() {
+    do_accept_local();
+    spdlog::info("HTTP server is listening on {} ...", options.local_path);
+}
+
+void HttpServer::do_accept_local() {
+    // a pipe instance serves one client, a fresh one waits for the next client as soon as one connects
+    HANDLE pipe = CreateNamedPipeA(options.local_path.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                   PIPE_UNLIMITED_INSTANCES, 64 * 1024, 64 * 1024, 0, nullptr);
+
+    if (pipe == INVALID_HANDLE_VALUE) {
+        spdlog::error("Error creating pipe {}: {}", options.local_path, GetLastError());
+        return;
+    }
+
+    auto strand = net::make_strand(ioc);
+    auto handle = std::make_shared<net::windows::stream_handle>(strand, pipe);
+
+    net::windows::overlapped_ptr overlapped(strand, [this, handle](beast::error_code ec, std::size_t) {
+        if (!ec) {
+            std::make_shared<HttpStreamSession<LocalStream>>(std::move(*handle), options, handler)->start();
+        } else if (ec != net::error::operation_aborted) {
+            spdlog::error("Error accepting pipe connection: {}", ec.message());
+        }
+
+        if (ec != net::error::operation_aborted) {
+            do_accept_local();
+        }
+    });
+
+    BOOL  connected = ConnectNamedPipe(pipe, overlapped.get());
+    DWORD error     = GetLastError();
+
+    if (!connected && error == ERROR_PIPE_CONNECTED) {
+        // the client connected between CreateNamedPipe and ConnectNamedPipe
+        overlapped.complete(beast::error_code(), 0);
+    } else if (!connected && error != ERROR_IO_PENDING) {
+        overlapped.complete(beast::error_code(static_cast<int>(error), net::error::get_system_category()), 0);
+    } else {
+        overlapped.release();
+    }
+}
+#else
+void HttpServer::start_local() {
+    // a socket file left behind by a previous run would fail the bind
+    ::unlink(options.local_path.c_str());
+
+    local_acceptor.emplace(net::make_strand(ioc));
+    local_acceptor->open(net::local::stream_protocol());
+    local_acceptor->bind(net::local::stream_protocol::endpoint(options.local_path));
+    local_acceptor->listen(net::socket_base::max_listen_connections);
+
+    // the control API has no authentication, only the server's user and group may connect
+    ::chmod(options.local_path.c_str(), 0660);
+
+    do_accept_local();
+    spdlog::info("HTTP server is listening on {} ...", options.local_path);
+}
+
+void HttpServer::do_accept_local() {
+    local_acceptor->async_accept(net::make_strand(ioc), [this](beast::error_code ec, net::local::stream_protocol::socket socket) {
+        if (!ec) {
+            std::make_shared<HttpStreamSession<LocalStream>>(std::move(socket), options, handler)->start();
+        } else if (ec == net::error::operation_aborted) {
+            return;
+        } else {
+            spdlog::error("Error accepting local connection: {}", ec.message());
+        }
+
+        do_accept_local();
+    });
+}
+#endif
+
+namespace {
+    // encode_body - compresses a body past the threshold if the request accepts it, then sets the length
+    void encode_body(const HttpRequest &request, http::response<http::string_body> &response) {
+        if (response.body().size() >= http_compression::min_bytes()) {
+            // big enough that the answer depends on Accept-Encoding, whatever this client asked for
+            response.set(http::field::vary, "Accept-Encoding");
+
+            if (auto coding = accepted_coding(request); coding != ContentCoding::identity) {
+                auto name = http_compression::name(coding);
+
+                response.body() = http_compression::compress(response.body(), coding);
+                response.set(http::field::content_encoding, beast::string_view(name.data(), name.size()));
+            }
+        }
+
+        response.prepare_payload();
+    }
+} // namespace
+
+ContentCoding accepted_coding(const HttpRequest &request) {
+    auto accept_encoding = request[http::field::accept_encoding];
+    return http_compression::negotiate(std::string_view(accept_encoding.data(), accept_encoding.size()));
+}
+
+http::response<http::string_body> json_response(const HttpRequest &request, http::status status, std::string body) {
+    http::response<http::string_body> response { status, request.version() };
+    response.set(http::field::server, "Boost.Beast");
+    response.set(http::field::content_type, "application/json");
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(body);
+    encode_body(request, response);
+    return response;
+}
+
+http::response<http::string_body> binary_response(const HttpRequest &request, http::status status, std::string body) {
+    http::response<http::string_body> response { status, request.version() };
+    response.set(http::field::server, "Boost.Beast");
+    response.set(http::field::content_type, "application/octet-stream");
+    response.set(http::field::cache_control, "no-store");
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(body);
+    response.prepare_payload();
+    return response;
+}
+
+http::response<http::empty_body> stream_header(const HttpRequest &request, std::string_view content_type) {
+    http::response<http::empty_body> response { http::status::ok, request.version() };
+    response.set(http::field::server, "Boost.Beast");
+    response.set(http::field::content_type, beast::string_view(content_type.data(), content_type.size()));
+    response.keep_alive(request.keep_alive());
+    return response;
+}
+
+http::response<http::string_body> too_many_requests(const HttpRequest &request, std::chrono::milliseconds retry_after) {
+    auto response = text_response(request, http::status::too_many_requests, "Too Many Requests");
+    response.set(http::field::retry_after, std::to_string(std::chrono::ceil<std::chrono::seconds>(retry_after).count()));
+    return response;
+}
+
+http::response<http::string_body> text_response(const HttpRequest &request, http::status status, std::string body) {
+    http::response<http::string_body> response { status, request.version() };
+    response.set(http::field::server, "Boost.Beast");
+    response.set(http::field::content_type, "text/plain");
+    response.keep_alive(request.keep_alive());
+    response.body() = std::move(body);
+    encode_body(request, response);
+    return response;
+}
@@ -0,0 +1,120 @@
+#include "json_writer.h"
+
+namespace {
+    constexpr char hex_digits[] = "0123456789abcdef";
+
+    void append_escaped_control(std::string &out, uint32_t c) {
+        switch (c) {
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            out += "\\u00";
+            out += hex_digits[c >> 4];
+            out += hex_digits[c & 0xF];
+            break;
+        }
+    }
+
+    void append_utf8(std::string &out, uint32_t code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+} // namespace
+
+void JsonWriter::write_string(std::string_view text) {
+    out += '"';
+
+    // copy runs that need no escaping in one go
+    size_t run_start = 0;
+
+    for (size_t i = 0; i < text.size(); i++) {
+        auto c = static_cast<unsigned char>(text[i]);
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        out.append(text.data() + run_start, i - run_start);
+        run_start = i + 1;
+
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else {
+            append_escaped_control(out, c);
+        }
+    }
+
+    out.append(text.data() + run_start, text.size() - run_start);
+    out += '"';
+}
+
+void JsonWriter::value_utf16(const wchar_t *text, size_t length) {
+    separate();
+
+    if (length > 0 && text[length - 1] == 0) {
+        length--;
+    }
+
+    out += '"';
+
+    for (size_t i = 0; i < length; i++) {
+        uint32_t c = static_cast<uint16_t>(text[i]);
+
+        if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length && text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (static_cast<uint16_t>(text[i + 1]) - 0xDC00);
+            i++;
+        } else if (c >= 0xD800 && c <= 0xDFFF) {
+            c = 0xFFFD; // unpaired surrogate
+        }
+
+        if (c < 0x20) {
+            append_escaped_control(out, c);
+        } else if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else {
+            append_utf8(out, c);
+        }
+    }
+
+    out += '"';
+}
+
+void JsonWriter::value_hex32(uint32_t number) {
+    separate();
+
+    char text[10] = { '"' };
+    for (int i = 0; i < 8; i++) {
+        text[8 - i] = hex_digits[(number >> (i * 4)) & 0xF];
+    }
+    text[9] = '"';
+
+    out.append(text, sizeof(text));
+}
@@ -0,0 +1,143 @@
+#include "loader_config.h"
+#include "spdlog/spdlog.h"
+
+#include <charconv>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace {
+    constexpr const char *config_path = "pal_loader.ini";
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    template<typename ValueType>
+    bool parse_value(std::string_view text, ValueType &out) {
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return ec == std::errc() && end == text.data() + text.size();
+    }
+
+    bool parse_value(std::string_view text, std::string &out) {
+        out = text;
+        return true;
+    }
+
+    // "a, b" - empty entries are skipped
+    bool parse_value(std::string_view text, std::vector<std::string> &out) {
+        out.clear();
+
+        while (!text.empty()) {
+            auto end  = text.find(',');
+            auto item = trim(text.substr(0, end));
+
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+            if (!item.empty()) {
+                out.emplace_back(item);
+            }
+        }
+        return true;
+    }
+
+    bool apply(LoaderConfig &config, std::string_view key, std::string_view value) {
+        if (key == "http_address") {
+            return parse_value(value, config.http_address);
+        }
+        if (key == "http_port") {
+            return parse_value(value, config.http_port);
+        }
+        if (key == "http_threads") {
+            return parse_value(value, config.http_threads);
+        }
+        if (key == "http_local_path") {
+            return parse_value(value, config.http_local_path);
+        }
+        if (key == "http_compression_min_bytes") {
+            return parse_value(value, config.http_compression_min_bytes);
+        }
+        if (key == "http_compression_level") {
+            return parse_value(value, config.http_compression_level);
+        }
+        if (key == "rcon_address") {
+            return parse_value(value, config.rcon_address);
+        }
+        if (key == "rcon_port") {
+            return parse_value(value, config.rcon_port);
+        }
+        if (key == "rcon_password") {
+            return parse_value(value, config.rcon_password);
+        }
+        if (key == "admission_read_rate") {
+            return parse_value(value, config.admission_read_rate);
+        }
+        if (key == "admission_read_burst") {
+            return parse_value(value, config.admission_read_burst);
+        }
+        if (key == "admission_write_rate") {
+            return parse_value(value, config.admission_write_rate);
+        }
+        if (key == "admission_write_burst") {
+            return parse_value(value, config.admission_write_burst);
+        }
+        if (key == "admission_tokens") {
+            return parse_value(value, config.admission_tokens);
+        }
+        if (key == "admission_game_thread_tasks") {
+            return parse_value(value, config.admission_game_thread_tasks);
+        }
+        if (key == "game_thread_budget_ms") {
+            return parse_value(value, config.game_thread_budget_ms);
+        }
+        if (key == "game_thread_window_ms") {
+            return parse_value(value, config.game_thread_window_ms);
+        }
+        if (key == "snapshot_interval_ms") {
+            return parse_value(value, config.snapshot_interval_ms);
+        }
+
+        spdlog::warn("{}: unknown key {}", config_path, key);
+        return true;
+    }
+
+    LoaderConfig load() {
+        LoaderConfig  config;
+        std::ifstream file(config_path);
+
+        if (!file) {
+            spdlog::info("{} not found, using defaults", config_path);
+            return config;
+        }
+
+        std::string line;
+        int         line_number = 0;
+
+        while (std::getline(file, line)) {
+            line_number++;
+
+            auto text = trim(line);
+            if (text.empty() || text.front() == '#' || text.front() == ';' || text.front() == '[') {
+                continue;
+            }
+
+            auto separator = text.find('=');
+            if (separator == std::string_view::npos || !apply(config, trim(text.substr(0, separator)), trim(text.substr(separator + 1)))) {
+                spdlog::warn("{}:{}: can't parse \"{}\"", config_path, line_number, text);
+            }
+        }
+
+        return config;
+    }
+} // namespace
+
+const LoaderConfig &loader_config() {
+    static const LoaderConfig config = load();
+    return config;
+}
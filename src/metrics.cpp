@@ -0,0 +1,176 @@
+#include "metrics.h"
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // bucket_index - bucket i holds (bound(i - 1), bound(i)] microseconds
+    size_t bucket_index(uint64_t us) {
+        if (us <= 16) {
+            return 0;
+        }
+
+        // on us - 1 the buckets are half open [16, 24) [24, 32) ..., the octave picks the pair, the next bit the half
+        uint64_t w      = us - 1;
+        int      octave = std::bit_width(w) - 1;
+        size_t   index  = 1 + (octave - 4) * 2 + ((w >> (octave - 1)) & 1);
+
+        return std::min(index, LatencyHistogram::num_buckets - 1);
+    }
+
+    struct Series {
+            std::string      family;
+            std::string      help;
+            std::string      labels;
+            LatencyHistogram histogram;
+    };
+
+    std::mutex                           registry_lock;
+    std::vector<std::unique_ptr<Series>> registry; // in registration order, a family's series are written together
+
+    void write_help(std::string &out, std::string_view name, std::string_view type, std::string_view help) {
+        fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    }
+
+    template<typename ValueType>
+    void write_single(std::string &out, std::string_view name, std::string_view type, std::string_view help, const std::atomic<ValueType> &value) {
+        write_help(out, name, type, help);
+        fmt::format_to(std::back_inserter(out), "{} {}\n", name, value.load(std::memory_order_relaxed));
+    }
+
+    void write_unlabeled(std::string &out, std::string_view name, std::string_view help, const LatencyHistogram &histogram) {
+        write_help(out, name, "histogram", help);
+        histogram.write_prometheus(out, name, {});
+    }
+} // namespace
+
+void LatencyHistogram::record(std::chrono::steady_clock::duration elapsed) {
+    auto ns = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+    buckets[bucket_index((ns + 999) / 1000)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::bucket_bound_us(size_t index) {
+    if (index == 0) {
+        return 16;
+    }
+
+    int octave = 4 + static_cast<int>(index - 1) / 2;
+    return (index - 1) % 2 ? uint64_t(2) << octave : uint64_t(3) << (octave - 1);
+}
+
+void LatencyHistogram::write_prometheus(std::string &out, std::string_view name, std::string_view labels) const {
+    auto     separator  = labels.empty() ? "" : ",";
+    uint64_t cumulative = 0;
+
+    // a scrape races record(), the counts can be a few increments apart but every line stays monotonic
+    for (size_t i = 0; i + 1 < num_buckets; i++) {
+        cumulative += buckets[i].load(std::memory_order_relaxed);
+        fmt::format_to(std::back_inserter(out), "{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator, bucket_bound_us(i) / 1e6, cumulative);
+    }
+
+    cumulative += buckets[num_buckets - 1].load(std::memory_order_relaxed);
+    fmt::format_to(std::back_inserter(out), "{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, labels, separator, cumulative);
+
+    auto braces_open  = labels.empty() ? "" : "{";
+    auto braces_close = labels.empty() ? "" : "}";
+
+    fmt::format_to(std::back_inserter(out), "{}_sum{}{}{} {}\n", name, braces_open, labels, braces_close, sum_ns.load(std::memory_order_relaxed) / 1e9);
+    fmt::format_to(std::back_inserter(out), "{}_count{}{}{} {}\n", name, braces_open, labels, braces_close, cumulative);
+}
+
+namespace metrics {
+    std::atomic<int64_t>  http_connections    = 0;
+    std::atomic<uint64_t> http_bytes_sent     = 0;
+    std::atomic<uint64_t> http_read_errors    = 0;
+    std::atomic<uint64_t> http_write_errors   = 0;
+    std::atomic<uint64_t> http_handler_errors = 0;
+    std::atomic<int64_t>  rcon_connections    = 0;
+
+    std::atomic<uint64_t> admission_rejected_reads  = 0;
+    std::atomic<uint64_t> admission_rejected_writes = 0;
+
+    LatencyHistogram game_thread_queue_wait;
+    LatencyHistogram game_thread_task_duration;
+    LatencyHistogram world_snapshot_capture;
+
+    std::string label(std::string_view key, std::string_view value) {
+        std::string out(key);
+        out += "=\"";
+
+        for (char c : value) {
+            if (c == '\\' || c == '"') {
+                out += '\\';
+                out += c;
+            } else if (c == '\n') {
+                out += "\\n";
+            } else {
+                out += c;
+            }
+        }
+
+        out += '"';
+        return out;
+    }
+
+    LatencyHistogram &histogram(std::string_view family, std::string_view help, std::string_view labels) {
+        std::lock_guard lock(registry_lock);
+
+        for (auto &series : registry) {
+            if (series->family == family && series->labels == labels) {
+                return series->histogram;
+            }
+        }
+
+        auto &series   = registry.emplace_back(std::make_unique<Series>());
+        series->family = family;
+        series->help   = help;
+        series->labels = labels;
+        return series->histogram;
+    }
+
+    void write_prometheus(std::string &out) {
+        write_single(out, "pal_http_connections", "gauge", "Open HTTP connections.", http_connections);
+        write_single(out, "pal_http_sent_bytes_total", "counter", "Bytes of HTTP responses written.", http_bytes_sent);
+
+        write_help(out, "pal_http_errors_total", "counter", "HTTP connections that failed reading or writing, and handlers that threw.");
+        fmt::format_to(std::back_inserter(out), "pal_http_errors_total{{kind=\"read\"}} {}\n", http_read_errors.load(std::memory_order_relaxed));
+        fmt::format_to(std::back_inserter(out), "pal_http_errors_total{{kind=\"write\"}} {}\n", http_write_errors.load(std::memory_order_relaxed));
+        fmt::format_to(std::back_inserter(out), "pal_http_errors_total{{kind=\"handler\"}} {}\n", http_handler_errors.load(std::memory_order_relaxed));
+
+        write_single(out, "pal_rcon_connections", "gauge", "Open RCON connections.", rcon_connections);
+
+        write_help(out, "pal_admission_rejected_total", "counter", "HTTP and RCON requests refused by rate limiting, by cost.");
+        fmt::format_to(std::back_inserter(out), "pal_admission_rejected_total{{cost=\"read\"}} {}\n", admission_rejected_reads.load(std::memory_order_relaxed));
+        fmt::format_to(std::back_inserter(out), "pal_admission_rejected_total{{cost=\"write\"}} {}\n", admission_rejected_writes.load(std::memory_order_relaxed));
+
+        write_unlabeled(out, "pal_game_thread_queue_wait_seconds", "Time game thread tasks waited in the queue.", game_thread_queue_wait);
+        write_unlabeled(out, "pal_game_thread_task_duration_seconds", "Time game thread tasks ran for.", game_thread_task_duration);
+        write_unlabeled(out, "pal_world_snapshot_capture_seconds", "Time the game thread spent capturing a world snapshot.", world_snapshot_capture);
+
+        std::lock_guard lock(registry_lock);
+
+        std::vector<bool> written(registry.size());
+
+        for (size_t i = 0; i < registry.size(); i++) {
+            if (written[i]) {
+                continue;
+            }
+
+            auto &family = registry[i]->family;
+            write_help(out, family, "histogram", registry[i]->help);
+
+            for (size_t j = i; j < registry.size(); j++) {
+                if (registry[j]->family == family) {
+                    registry[j]->histogram.write_prometheus(out, family, registry[j]->labels);
+                    written[j] = true;
+                }
+            }
+        }
+    }
+} // namespace metrics
@@ -0,0 +1,264 @@
+#include <windows.h>
+#include "platform_sdk.h"
+#include "signature_scanner.h"
+#include "spdlog/spdlog.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr const char *offset_cache_path = "pal_loader_offsets.cache";
+
+    enum class SignatureKind {
+        Function,    // the match is the function start
+        RipRelative, // the match is an instruction addressing the global with [rip + disp32]
+    };
+
+    struct OffsetSignature {
+        const char   *name;
+        int32_t      *offset;
+        const char   *section;
+        const char   *pattern;
+        SignatureKind kind;
+        int32_t       displacement_at;
+        int32_t       instruction_end;
+        bool          required; // the SDK reads it, the loader can't run without it. Others are set to 0 and their features stay off.
+    };
+
+    // UE5 signatures. A dumped offset is never used unverified, after a game update it points into some other code.
+    OffsetSignature signatures[] = {
+        { "GObjects", &Offsets::GObjects, ".text", "48 8B 05 ?? ?? ?? ?? 48 8B 0C C8 48 8D 04 D1", SignatureKind::RipRelative, 3, 7, true },
+        { "GWorld", &Offsets::GWorld, ".text", "48 8B 1D ?? ?? ?? ?? 48 85 DB 74 ?? 41 B0 01", SignatureKind::RipRelative, 3, 7, true },
+        { "AppendString", &Offsets::AppendString, ".text", "48 89 5C 24 ?? 48 89 74 24 ?? 57 48 83 EC 20 80 3D ?? ?? ?? ?? ?? 48 8B FA 8B D9 74 ?? 4C 8D 44 24", SignatureKind::Function, 0, 0, true },
+        { "ProcessEvent", &Offsets::ProcessEvent, ".text", "40 55 56 57 41 54 41 55 41 56 41 57 48 81 EC ?? ?? ?? ?? 48 8D 6C 24 ?? 48 89 9D ?? ?? ?? ?? 48 8B 05 ?? ?? ?? ?? 48 33 C5 48 89 85 ?? ?? ?? ?? 8B 41 0C", SignatureKind::Function, 0, 0, false },
+        { "ForceGarbageCollection", &Offsets::ForceGarbageCollection, ".text", "48 89 5C 24 ?? 57 48 83 EC 20 0F B6 FA 48 8B D9 E8 ?? ?? ?? ?? F3 0F 58 05 ?? ?? ?? ?? 40 08 BB ?? ?? ?? ??", SignatureKind::Function, 0, 0, false },
+        { "LowLevelGetRemoteAddress", &Offsets::LowLevelGetRemoteAddress, ".text", "48 89 5C 24 ?? 48 89 74 24 ?? 57 48 83 EC 40 41 0F B6 F0 48 8B DA 48 8B F9 48 8B 89 ?? ?? ?? ?? 48 85 C9 74", SignatureKind::Function, 0, 0, false },
+        { "KickPlayer", &Offsets::KickPlayer, ".text", "48 89 5C 24 ?? 48 89 6C 24 ?? 48 89 74 24 ?? 57 48 83 EC 30 49 8B F0 48 8B EA E8 ?? ?? ?? ?? 48 8B D8 48 85 C0 74 ?? 48 8B C8 E8", SignatureKind::Function, 0, 0, false },
+        { "GetEmptyFText", &Offsets::GetEmptyFText, ".text", "48 83 EC 28 65 48 8B 04 25 58 00 00 00 8B 0D ?? ?? ?? ?? BA ?? ?? ?? ?? 48 8B 0C C8 8B 04 0A 39 05 ?? ?? ?? ?? 7F ?? 48 8D 05 ?? ?? ?? ?? 48 83 C4 28 C3", SignatureKind::Function, 0, 0, false },
+        { "SpawnPlayActor", &Offsets::SpawnPlayActor, ".text", "48 8B C4 55 53 56 57 41 54 41 55 41 56 41 57 48 8D A8 ?? ?? ?? ?? 48 81 EC ?? ?? ?? ?? 0F 29 70 ?? 48 8B 05 ?? ?? ?? ?? 48 33 C4 48 89 85 ?? ?? ?? ?? 4C 8B A5", SignatureKind::Function, 0, 0, false },
+        // FUObjectArray::AllocateSerialNumber, MasterSerialNumber.Increment() then the compare exchange on the item
+        { "MasterSerialNumber", &Offsets::MasterSerialNumber, ".text", "B8 01 00 00 00 F0 0F C1 05 ?? ?? ?? ?? FF C0 8B C8 33 C0 F0 0F B1 4A 10", SignatureKind::RipRelative, 9, 13, false },
+    };
+
+    struct ImageSection {
+        const uint8_t *data = nullptr;
+        size_t         size = 0;
+    };
+
+    const IMAGE_NT_HEADERS64 *get_nt_headers(uintptr_t image_base) {
+        auto dos = reinterpret_cast<const IMAGE_DOS_HEADER *>(image_base);
+        if (dos->e_magic != IMAGE_DOS_SIGNATURE) {
+            return nullptr;
+        }
+
+        auto nt = reinterpret_cast<const IMAGE_NT_HEADERS64 *>(image_base + dos->e_lfanew);
+        return nt->Signature == IMAGE_NT_SIGNATURE ? nt : nullptr;
+    }
+
+    ImageSection find_section(uintptr_t image_base, const IMAGE_NT_HEADERS64 *nt, std::string_view name) {
+        auto section = IMAGE_FIRST_SECTION(nt);
+
+        for (WORD i = 0; i < nt->FileHeader.NumberOfSections; i++, section++) {
+            std::string_view section_name(reinterpret_cast<const char *>(section->Name), strnlen(reinterpret_cast<const char *>(section->Name), IMAGE_SIZEOF_SHORT_NAME));
+
+            if (section_name == name) {
+                return { reinterpret_cast<const uint8_t *>(image_base + section->VirtualAddress), section->Misc.VirtualSize };
+            }
+        }
+
+        return {};
+    }
+
+    // drop_unresolved - offsets no signature found are stale, false if one the loader can't run without is among them
+    bool drop_unresolved(const std::vector<bool> &resolved) {
+        bool required_resolved = true;
+
+        for (size_t i = 0; i < std::size(signatures); i++) {
+            auto &signature = signatures[i];
+
+            if (resolved[i]) {
+                continue;
+            }
+
+            if (signature.required) {
+                spdlog::critical("{} not found by signature", signature.name);
+                required_resolved = false;
+                continue;
+            }
+
+            spdlog::error("{} not found by signature, {} disabled", signature.name, signature.name);
+            *signature.offset = 0;
+        }
+
+        return required_resolved;
+    }
+
+    // The headers carry the link timestamp, checksum and section table, so every game build hashes differently.
+    uint64_t hash_image(uintptr_t image_base, const IMAGE_NT_HEADERS64 *nt) {
+        auto     bytes = reinterpret_cast<const uint8_t *>(image_base);
+        uint64_t hash  = 0xCBF29CE484222325ull;
+
+        for (DWORD i = 0; i < nt->OptionalHeader.SizeOfHeaders; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+        }
+
+        return hash;
+    }
+
+    // load_offset_cache - false if there is no cache for this image, resolved tells which offsets it had
+    bool load_offset_cache(uint64_t image_hash, std::vector<bool> &resolved) {
+        std::ifstream file(offset_cache_path);
+        if (!file) {
+            return false;
+        }
+
+        std::unordered_map<std::string, int32_t> cached;
+        std::string                              line;
+        bool                                     hash_matches = false;
+
+        while (std::getline(file, line)) {
+            auto separator = line.find('=');
+            if (line.empty() || line[0] == '#' || separator == std::string::npos) {
+                continue;
+            }
+
+            uint64_t value = 0;
+            auto [end, ec] = std::from_chars(line.data() + separator + 1, line.data() + line.size(), value, 16);
+            if (ec != std::errc()) {
+                continue;
+            }
+
+            auto key = line.substr(0, separator);
+
+            if (key == "image") {
+                hash_matches = value == image_hash;
+            } else {
+                cached[key] = static_cast<int32_t>(value);
+            }
+        }
+
+        if (!hash_matches) {
+            return false;
+        }
+
+        for (size_t i = 0; i < std::size(signatures); i++) {
+            if (auto it = cached.find(signatures[i].name); it != cached.end()) {
+                *signatures[i].offset = it->second;
+                resolved[i]           = true;
+            }
+        }
+
+        return true;
+    }
+
+    // save_offset_cache - only offsets that were found are written, a failed signature fails the same way on the next run
+    void save_offset_cache(uint64_t image_hash, const std::vector<bool> &resolved) {
+        std::ofstream file(offset_cache_path, std::ios::trunc);
+        if (!file) {
+            spdlog::warn("can't write {}", offset_cache_path);
+            return;
+        }
+
+        file << "# offsets resolved by signature, deleted or rebuilt automatically when the game updates\n";
+        file << "image=" << std::hex << image_hash << "\n";
+
+        for (size_t i = 0; i < std::size(signatures); i++) {
+            if (resolved[i]) {
+                file << signatures[i].name << "=" << std::hex << *signatures[i].offset << "\n";
+            }
+        }
+    }
+} // namespace
+
+bool ResolveOffsets() {
+    auto start      = std::chrono::steady_clock::now();
+    auto image_base = GetImageBaseOffset();
+    auto nt         = get_nt_headers(image_base);
+
+    if (!nt) {
+        spdlog::critical("image headers not found");
+        return false;
+    }
+
+    auto image_hash = hash_image(image_base, nt);
+
+    std::vector<bool> resolved(std::size(signatures));
+
+    if (load_offset_cache(image_hash, resolved)) {
+        spdlog::info("offsets loaded from {} (image {:016x})", offset_cache_path, image_hash);
+
+        return drop_unresolved(resolved);
+    }
+
+    // one pass per section, every pattern of the section is scanned in that pass
+    std::unordered_map<std::string_view, std::vector<size_t>> by_section;
+    std::vector<BytePattern>                                  patterns(std::size(signatures));
+
+    for (size_t i = 0; i < std::size(signatures); i++) {
+        auto pattern = BytePattern::parse(signatures[i].pattern);
+        if (!pattern) {
+            spdlog::error("bad signature for {}", signatures[i].name);
+            continue;
+        }
+
+        patterns[i] = std::move(*pattern);
+        by_section[signatures[i].section].push_back(i);
+    }
+
+    for (auto &[section_name, indices] : by_section) {
+        auto section = find_section(image_base, nt, section_name);
+        if (!section.data) {
+            spdlog::error("section {} not found", section_name);
+            continue;
+        }
+
+        std::vector<BytePattern> section_patterns;
+        for (auto i : indices) {
+            section_patterns.push_back(patterns[i]);
+        }
+
+        auto matches = scan_patterns(section.data, section.size, section_patterns);
+
+        for (size_t m = 0; m < indices.size(); m++) {
+            auto &signature = signatures[indices[m]];
+            auto &match     = matches[m];
+
+            if (match.count != 1) {
+                spdlog::warn("signature for {} matched {} times", signature.name, match.count == 0 ? "0" : "2+");
+                continue;
+            }
+
+            uintptr_t address = uintptr_t(match.first);
+
+            if (signature.kind == SignatureKind::RipRelative) {
+                int32_t displacement;
+                memcpy(&displacement, match.first + signature.displacement_at, sizeof(displacement));
+                address = address + signature.instruction_end + displacement;
+            }
+
+            if (address < image_base || address >= image_base + nt->OptionalHeader.SizeOfImage) {
+                spdlog::warn("signature for {} points outside the image", signature.name);
+                continue;
+            }
+
+            int32_t offset = static_cast<int32_t>(address - image_base);
+            if (offset != *signature.offset) {
+                spdlog::info("{} moved 0x{:X} -> 0x{:X}", signature.name, *signature.offset, offset);
+            }
+
+            *signature.offset    = offset;
+            resolved[indices[m]] = true;
+        }
+    }
+
+    save_offset_cache(image_hash, resolved);
+
+    spdlog::info("offsets resolved by signature in {} ms (image {:016x}, {})", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count(), image_hash, scanner_uses_avx2() ? "AVX2" : "SSE2");
+    return drop_unresolved(resolved);
+}
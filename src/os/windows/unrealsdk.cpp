@@ -1,6 +1,50 @@
 #include <windows.h>
+#include <tlhelp32.h>
 #include "sdk.hpp"
 
 uintptr_t GetImageBaseOffset() {
     return uintptr_t(GetModuleHandle(0));
 }
+
+uint32_t GetGameThreadId() {
+    // the main thread is the oldest one of the process, the loader's own threads all came later
+    static const uint32_t game_thread_id = [] {
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) {
+            return DWORD(0);
+        }
+
+        DWORD         process = GetCurrentProcessId();
+        DWORD         oldest  = 0;
+        ULONGLONG     created = ~0ull;
+        THREADENTRY32 entry   = { sizeof(entry) };
+
+        for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID != process) {
+                continue;
+            }
+
+            HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+            if (!thread) {
+                continue;
+            }
+
+            FILETIME creation, exit, kernel, user;
+            if (GetThreadTimes(thread, &creation, &exit, &kernel, &user)) {
+                ULONGLONG time = (ULONGLONG(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+
+                if (time < created) {
+                    created = time;
+                    oldest  = entry.th32ThreadID;
+                }
+            }
+
+            CloseHandle(thread);
+        }
+
+        CloseHandle(snapshot);
+        return oldest;
+    }();
+
+    return game_thread_id;
+}
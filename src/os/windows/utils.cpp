@@ -19,4 +19,31 @@ std::string utf16_to_local_codepage(wchar_t * data, size_t len) {
     std::string result(cstr, used);
     free(cstr);
     return result;
-}
\ No newline at end of file
+}
+
+std::string utf16_to_utf8(const wchar_t *data, size_t len) {
+    // FString counts its terminator
+    if (len > 0 && data[len - 1] == 0) {
+        len--;
+    }
+
+    size_t      need = WideCharToMultiByte(CP_UTF8, 0, data, len, 0, 0, 0, 0);
+    std::string result(need, 0);
+    size_t      used = WideCharToMultiByte(CP_UTF8, 0, data, len, result.data(), need, 0, 0);
+    result.resize(used);
+    return result;
+}
+
+std::wstring utf8_to_utf16(const std::string &utf8) {
+    int          size = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, nullptr, 0);
+    std::wstring utf16(size, 0);
+    MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, &utf16[0], size);
+    return utf16;
+}
+
+std::string wide_to_narrow(const std::wstring &wide) {
+    int         narrow_size = WideCharToMultiByte(CP_ACP, 0, wide.c_str(), -1, nullptr, 0, nullptr, nullptr);
+    std::string narrow(narrow_size, 0);
+    WideCharToMultiByte(CP_ACP, 0, wide.c_str(), -1, &narrow[0], narrow_size, nullptr, nullptr);
+    return narrow;
+}
@@ -5,11 +5,21 @@
 #include "hooks.h"
 #include "utils.h"
 #include "engine_functions.h"
-
+#include "game_fields.h"
+#include "game_functions.h"
+#include "admission.h"
+#include "commands.h"
+#include "game_thread.h"
+#include "loader_config.h"
+#include "http_api.h"
+#include "http_compression.h"
+#include "rcon_server.h"
+#include "world_snapshot.h"
+#include "event_stream.h"
+
+#include <chrono>
 #include <cstdio>
 #include <iostream>
-#include <boost/asio.hpp>
-#include <boost/beast.hpp>
 #include <string>
 #include <windows.h>
 
@@ -18,342 +28,180 @@ LowLevelGetRemoteAddressType LowLevelGetRemoteAddress = nullptr;
 KickPlayerType               KickPlayer               = nullptr;
 GetEmptyFTextType            GetEmptyFText            = nullptr;
 
-std::string str_tolower(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
-        return std::tolower(c);
-    });
-    return s;
-}
-
-namespace net   = boost::asio;  // from <boost/asio.hpp>
-namespace beast = boost::beast; // from <boost/beast.hpp>
-namespace http  = beast::http;  // from <boost/beast/http.hpp>
-using tcp       = net::ip::tcp; // from <boost/asio/ip/tcp.hpp>
-
-
-struct SDKContext {
-        SDK::UEngine              *engine;
-        SDK::UWorld               *world;
-        SDK::UPalUtility          *utility;
-        SDK::APalGameStateInGame  *stateInGame;
-        ForceGarbageCollectionType forceGarbageCollection;
-
-        SDKContext(SDK::UEngine *eng, SDK::UWorld *wrld, SDK::UPalUtility *util, SDK::APalGameStateInGame *state, ForceGarbageCollectionType fgc)
-            : engine(eng), world(wrld), utility(util), stateInGame(state), forceGarbageCollection(fgc) {}
-};
-
-std::wstring utf8_to_utf16(const std::string &utf8) {
-    int          size = MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, nullptr, 0);
-    std::wstring utf16(size, 0);
-    MultiByteToWideChar(CP_UTF8, 0, utf8.c_str(), -1, &utf16[0], size);
-    return utf16;
-}
-
-std::string wide_to_narrow(const std::wstring &wide) {
-    // ʹ��CP_ACP����ת���������ַ���ת��ΪANSI�����խ�ַ���
-    int         narrow_size = WideCharToMultiByte(CP_ACP, 0, wide.c_str(), -1, nullptr, 0, nullptr, nullptr);
-    std::string narrow(narrow_size, 0);
-    WideCharToMultiByte(CP_ACP, 0, wide.c_str(), -1, &narrow[0], narrow_size, nullptr, nullptr);
-    return narrow;
-}
-
-std::string get_query_parameter(const std::string &query, const std::string &key) {
-    std::string key_with_equal = key + "=";
-    size_t      start_pos      = query.find(key_with_equal);
-
-    if (start_pos == std::string::npos)
-        return ""; // û�ҵ�����
-
-    // ����key�͵Ⱥ�
-    start_pos += key_with_equal.length();
-    size_t end_pos = query.find("&", start_pos);
-
-    if (end_pos == std::string::npos) {
-        return query.substr(start_pos);
-    }
-
-    return query.substr(start_pos, end_pos - start_pos);
-}
-
-std::string url_decode(const std::string &input) {
-    std::string result;
-    result.reserve(input.size());
-
-    for (size_t i = 0; i < input.size(); ++i) {
-        if (input[i] == '+') {
-            result += ' ';
-        } else if (input[i] == '%' && i + 2 < input.size()) {
-            std::string hex          = input.substr(i + 1, 2);
-            char        decoded_char = static_cast<char>(std::stoi(hex, nullptr, 16));
-            result += decoded_char;
-            i += 2; // Skip next two characters
-        } else {
-            result += input[i];
-        }
-    }
 
-    return result;
-}
-
-void handle_request(http::request<http::string_body> &&req, http::response<http::string_body> &res, std::shared_ptr<SDKContext> sdkContext) {
+void pal_loader_thread_start() {
+    spdlog::info("loading ...");
 
-     spdlog::info("Handling request for target: {}", std::string(req.target()));
-    if (req.method() != http::verb::get) {
-        res = { http::status::method_not_allowed, req.version() };
-        res.set(http::field::content_type, "text/plain");
-        res.keep_alive(req.keep_alive());
-        res.body() = "Method Not Allowed";
-        res.prepare_payload();
+    if (!ResolveOffsets()) {
+        spdlog::critical("offsets the SDK needs don't match this server build, loader stopped");
         return;
     }
 
-    // ȷ�������·��
-    if (req.target().starts_with("/rcon?")) {
-        // ���������URL����
-        auto target         = req.target();
-        auto params         = target.substr(target.find("?") + 1);
-        auto decoded_params = url_decode(params);
-
-        // ��ȡ����֤`text`����
-        auto text_param = get_query_parameter(decoded_params, "text"); 
-        if (text_param.empty()) {
-            res = { http::status::bad_request, req.version() };
-            res.set(http::field::content_type, "text/plain");
-            res.keep_alive(req.keep_alive());
-            res.body() = "Bad Request: missing 'text' parameter";
-            res.prepare_payload();
-            return;
-        }
-
-        // �����Ǵ�������ĵط�����������Ϊ�����ʾ��
-        std::string command_result = "Received command: " + text_param; 
-
-        if (text_param == "state") {
-            spdlog::info("[CMD::State] WorldName               = {}", sdkContext->stateInGame->GetWorldName().ToString());
-            spdlog::info("[CMD::State] World Save Directory    = {}", sdkContext->stateInGame->WorldSaveDirectoryName.ToString());
-            spdlog::info("[CMD::State] Server Frame Time       = {}", sdkContext->stateInGame->GetServerFrameTime());
-            spdlog::info("[CMD::State] Max Player              = {}", sdkContext->stateInGame->GetMaxPlayerNum());
-        } else if (text_param.starts_with("broadcast")) {
-            auto message_utf8 = text_param.substr(10);
+    SDK::InitGObjects();
 
-            // ��UTF-8�ַ���ת��ΪUTF-16
-            std::wstring message_utf16 = utf8_to_utf16(message_utf8);
+    auto index_start = std::chrono::steady_clock::now();
+    SDK::FObjectNameIndex::Build();
+    spdlog::info("indexed {} objects ({} names) in {} ms", SDK::FObjectNameIndex::NumIndexed(), SDK::FNameCache::Num(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - index_start).count());
 
-            // ʹ��ת�����UTF-16�ַ���
-            sdkContext->utility->SendSystemAnnounce(sdkContext->world, SDK::FString(message_utf16.c_str()));
+    auto hierarchy_start = std::chrono::steady_clock::now();
+    SDK::FClassHierarchy::Build();
+    spdlog::info("numbered {} classes in {} ms", SDK::FClassHierarchy::NumClasses(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - hierarchy_start).count());
 
-            // �����ַ���ת��Ϊխ�ַ���������־
-            std::string message_narrow = wide_to_narrow(message_utf16);
-            spdlog::info("[CMD::BroadcastChatMessage] {}", message_narrow);
-        } else if (text_param == "gc") {
-            sdkContext->forceGarbageCollection(sdkContext->engine, true);
+    std::vector<std::string> missing_functions;
 
-            spdlog::info("[CMD::ForceGarbageCollection] done");
-        } else {
-            spdlog::info("[CMD::???] Unknown command");
+    if (!SDK::FFunctionTable::Resolve(&missing_functions)) {
+        for (auto &function : missing_functions) {
+            spdlog::critical("UFunction not found: {}", function);
         }
 
-
-        // ����HTTP��Ӧ
-        res = { http::status::ok, req.version() };
-        res.set(http::field::server, "Boost.Beast");
-        res.set(http::field::content_type, "text/plain");
-        res.keep_alive(req.keep_alive());
-        res.body() = command_result;
-        res.prepare_payload();
-    } else {
-        // ����δ֪·��
-        res = { http::status::not_found, req.version() };
-        res.set(http::field::content_type, "text/plain");
-        res.keep_alive(req.keep_alive());
-        res.body() = "Not Found";
-        res.prepare_payload();
+        spdlog::critical("{} UFunction(s) missing, the SDK does not match this server build, loader stopped", missing_functions.size());
+        return;
     }
-}
 
+    std::vector<std::string> failed_fields;
 
-void http_server(tcp::acceptor &acceptor, std::shared_ptr<SDKContext> sdkContext) {
-    // �����µ�socket
-    auto socket = std::make_shared<tcp::socket>(acceptor.get_executor());
-
-    acceptor.async_accept(*socket, [&acceptor, socket, sdkContext](boost::system::error_code ec) {
-        if (!ec) {
-            spdlog::info("New connection accepted");
-
-            auto buffer = std::make_shared<beast::flat_buffer>();
-            auto req    = std::make_shared<http::request<http::string_body>>();
-
-            http::async_read(*socket, *buffer, *req, [socket, req, buffer, sdkContext](beast::error_code ec, std::size_t bytes_transferred) {
-                if (!ec) {
-                    spdlog::info("Received HTTP request: {}", std::string(req->target()));
-                    http::response<http::string_body> res;
-                    handle_request(std::move(*req), res, sdkContext);
-                    http::write(*socket, res);
-                    spdlog::info("HTTP response sent");
-                } else {
-                    spdlog::error("Error reading HTTP request: {}", ec.message());
-                }
-            });
-        } else {
-            spdlog::error("Error accepting connection: {}", ec.message());
+    // a missing field or one that changed type would be read at an offset that means nothing in this build
+    if (!SDK::FRuntimeFields::Resolve(&failed_fields)) {
+        for (auto &field : failed_fields) {
+            spdlog::critical("Field not found by reflection or changed type: {}", field);
         }
 
-        // ׼����һ������
-        http_server(acceptor, sdkContext);
-    });
-}
-
-
-
-void pal_loader_thread_start() {
-    spdlog::info("loading ...");
-
-    SDK::InitGObjects();
+        spdlog::critical("{} field(s) don't match, the SDK does not match this server build, loader stopped", failed_fields.size());
+        return;
+    }
 
     SDK::UEngine             *engine      = nullptr;
     SDK::UWorld              *world       = nullptr;
     SDK::UPalUtility         *utility     = nullptr;
     SDK::APalGameStateInGame *stateInGame = nullptr;
 
-    for (int i = 0; i < SDK::UObject::GObjects->Num(); i++) {
-        SDK::UObject *object = SDK::UObject::GObjects->GetByIndex(i);
-
-        if (!object)
-            continue;
+    SDK::UObject::GObjects->ForEachObjectOfClass(SDK::UEngine::StaticClass(), [&engine](SDK::UObject *object) {
+        if (object->IsDefaultObject())
+            return true;
 
-        if (object->IsA(SDK::UEngine::StaticClass()) && !object->IsDefaultObject()) {
-            engine = static_cast<SDK::UEngine *>(object);
-            break;
-        }
-    }
+        engine = static_cast<SDK::UEngine *>(object);
+        return false;
+    });
 
     world = *reinterpret_cast<SDK::UWorld **>(uintptr_t(GetImageBaseOffset()) + Offsets::GWorld);
 
     utility = SDK::UPalUtility::GetDefaultObj();
 
-    stateInGame = utility->GetPalGameStateInGame(world);
+    stateInGame = game_functions::get_pal_game_state_in_game(utility, world);
 
-    ForceGarbageCollection   = reinterpret_cast<ForceGarbageCollectionType>(uintptr_t(GetImageBaseOffset()) + Offsets::ForceGarbageCollection);
-    LowLevelGetRemoteAddress = reinterpret_cast<LowLevelGetRemoteAddressType>(uintptr_t(GetImageBaseOffset()) + Offsets::LowLevelGetRemoteAddress);
-    KickPlayer               = reinterpret_cast<KickPlayerType>(uintptr_t(GetImageBaseOffset()) + Offsets::KickPlayer);
-    GetEmptyFText            = reinterpret_cast<GetEmptyFTextType>(uintptr_t(GetImageBaseOffset()) + Offsets::GetEmptyFText);
+    // ResolveOffsets zeroes the offsets that don't match this build, those functions stay nullptr
+    auto image_function = [](int32_t offset) {
+        return offset ? uintptr_t(GetImageBaseOffset()) + offset : uintptr_t(0);
+    };
+
+    ForceGarbageCollection   = reinterpret_cast<ForceGarbageCollectionType>(image_function(Offsets::ForceGarbageCollection));
+    LowLevelGetRemoteAddress = reinterpret_cast<LowLevelGetRemoteAddressType>(image_function(Offsets::LowLevelGetRemoteAddress));
+    KickPlayer               = reinterpret_cast<KickPlayerType>(image_function(Offsets::KickPlayer));
+    GetEmptyFText            = reinterpret_cast<GetEmptyFTextType>(image_function(Offsets::GetEmptyFText));
 
     spdlog::info("Unreal::GObjects         = {:x}", uintptr_t(SDK::UObject::GObjects));
     spdlog::info("Unreal::GEngine          = {}", uintptr_t(engine));
     spdlog::info("Unreal::GWorld           = {}", uintptr_t(world));
     spdlog::info("UPalUtility              = {:x}", uintptr_t(utility));
     spdlog::info("PalGameStateInGame       = {:x}", uintptr_t(stateInGame));
-    spdlog::info("IsDevelopmentBuild       = {}", utility->IsDevelopmentBuild());
-
-    install_hooks();
+    spdlog::info("IsDevelopmentBuild       = {}", game_functions::is_development_build(utility));
 
-    // Now wo can do some magic!
-
-    // Hook code removed, it's unstable
-
-    // ����HTTP������
+    auto sdkContext = std::make_shared<SDKContext>(engine, world, utility, stateInGame, ForceGarbageCollection);
 
-     try {
-            auto const      address = net::ip::make_address("127.0.0.1");
-            auto const      port    = static_cast<unsigned short>(53000);
-            net::io_context ioc { 1 };
+    auto &config = loader_config();
+    game_thread::set_budget(std::chrono::microseconds(static_cast<int64_t>(config.game_thread_budget_ms * 1000)), std::chrono::microseconds(static_cast<int64_t>(config.game_thread_window_ms * 1000)));
 
-            tcp::acceptor acceptor { ioc, { address, port } };
-            auto          sdkContext = std::make_shared<SDKContext>(engine, world, utility, stateInGame, ForceGarbageCollection);
-
-            http_server(acceptor, sdkContext);
-
-            spdlog::info("HTTP server is running at 127.0.0.1:53000 ...");
-            ioc.run();
-        } catch (std::exception const &e) {
-            spdlog::error("Exception: {}", e.what());
-        }
-    
+    world_snapshot::start(sdkContext, std::chrono::milliseconds(config.snapshot_interval_ms));
 
+    if (!install_hooks()) {
+        spdlog::warn("hooks not installed, commands run outside the game thread");
+    }
 
-    while (true) {
-        std::cout << "Pal Loader > ";
-        std::string userInput;
-        std::getline(std::cin, userInput);
+    // Now wo can do some magic!
 
-        if (userInput == "state") {
-            spdlog::info("[CMD::State] WorldName               = {}", stateInGame->GetWorldName().ToString());
-            spdlog::info("[CMD::State] World Save Directory    = {}", stateInGame->WorldSaveDirectoryName.ToString());
-            spdlog::info("[CMD::State] Server Frame Time       = {}", stateInGame->GetServerFrameTime());
-            spdlog::info("[CMD::State] Max Player              = {}", stateInGame->GetMaxPlayerNum());
-        } else if (userInput.starts_with("broadcast")) {
-            auto message = userInput.substr(10);
+    // Hook code removed, it's unstable
 
+    // ����HTTP������
 
-            utility->SendSystemAnnounce(world, SDK::FString(std::wstring(message.begin(), message.end()).c_str()));
+    HttpServerOptions http_options;
+    http_options.address    = config.http_address;
+    http_options.port       = static_cast<unsigned short>(config.http_port);
+    http_options.threads    = config.http_threads;
+    http_options.local_path = config.http_local_path;
 
-            spdlog::info("[CMD::BroadcastChatMessage] {}", message);
-        } else if (userInput == "gc") {
-            ForceGarbageCollection(engine, true);
+    AdmissionOptions admission_options;
+    admission_options.read_rate         = config.admission_read_rate;
+    admission_options.read_burst        = config.admission_read_burst;
+    admission_options.write_rate        = config.admission_write_rate;
+    admission_options.write_burst       = config.admission_write_burst;
+    admission_options.game_thread_tasks = config.admission_game_thread_tasks;
+    admission_options.window            = std::chrono::microseconds(static_cast<int64_t>(config.game_thread_window_ms * 1000));
+    admission_options.tokens            = config.admission_tokens;
 
-            spdlog::info("[CMD::ForceGarbageCollection] done");
-        } else if (userInput == "list") {
-            SDK::TArray<SDK::APalCharacter *> player_characters;
+    admission::configure(admission_options);
 
-            utility->GetAllPlayerCharacters(world, &player_characters);
+    http_compression::configure(config.http_compression_min_bytes > 0 ? static_cast<size_t>(config.http_compression_min_bytes) : 0, config.http_compression_level);
 
-            if (player_characters.IsValid()) {
-                spdlog::info("[CMD::List] current {} player online", player_characters.Num());
+    auto router = std::make_shared<HttpRouter>();
+    register_http_routes(*router, sdkContext);
 
-                for (int i = 0; i < player_characters.Num(); i++) {
-                    auto character = static_cast<SDK::APalPlayerCharacter *>(player_characters[i]);
+    HttpServer http_server(http_options, [router](HttpRequest &&req, HttpResponder responder) {
+        spdlog::debug("Handling request for target: {}", std::string(req.target()));
+        router->dispatch(std::move(req), std::move(responder));
+    });
 
-                    auto controller = static_cast<SDK::APlayerController *>(character->GetController());
+    events::start(http_server.context().get_executor());
 
-                    std::string address = std::string("[UNK]");
+    try {
+        http_server.start();
+    } catch (std::exception const &e) {
+        spdlog::error("Exception: {}", e.what());
+    }
 
-                    if (controller->NetConnection) {
-                        auto fsaddress = LowLevelGetRemoteAddress(static_cast<SDK::UIpConnection *>(controller->NetConnection), true);
+    RconServerOptions rcon_options;
+    rcon_options.address  = config.rcon_address;
+    rcon_options.port     = static_cast<unsigned short>(config.rcon_port);
+    rcon_options.password = config.rcon_password;
 
-                        if (fsaddress && fsaddress->IsValid() && fsaddress->Num() > 1) {
-                            address = fsaddress->ToString();
-                        }
-                    }
+    RconServer rcon_server(http_server.context(), rcon_options, sdkContext);
 
-                    auto state    = utility->GetPlayerStateByPlayer(character);
-                    auto raw_name = state->GetPlayerName();
-                    auto uid      = utility->GetPlayerUIDByActor(character);
+    if (config.rcon_password.empty()) {
+        spdlog::info("rcon_password not set, RCON server disabled");
+    } else {
+        try {
+            rcon_server.start();
+        } catch (std::exception const &e) {
+            spdlog::error("RCON server: {}", e.what());
+        }
+    }
 
-                    std::string name = utf16_to_local_codepage(raw_name.Data, raw_name.NumElements);
+    while (true) {
+        std::cout << "Pal Loader > ";
+        std::string userInput;
 
-                    spdlog::info("[CMD::List] {}, {:08x}, {}", name, static_cast<uint32_t>(uid.A), address);
-                }
-            }
-        } else if (userInput.starts_with("kick")) {
-            auto                              kick_uid = str_tolower(userInput.substr(5));
-            SDK::TArray<SDK::APalCharacter *> player_characters;
-            utility->GetAllPlayerCharacters(world, &player_characters);
+        if (!std::getline(std::cin, userInput)) {
+            // no console [closed or redirected], the servers own this thread's locals and keep running
+            spdlog::info("console input closed, commands only through the HTTP API and RCON");
+            Sleep(INFINITE);
+        }
 
-            if (player_characters.IsValid()) {
-                for (int i = 0; i < player_characters.Num(); i++) {
-                    char        hexuid[9] = {};
-                    auto        character = static_cast<SDK::APalPlayerCharacter *>(player_characters[i]);
-                    auto        uid       = utility->GetPlayerUIDByActor(character);
-                    auto        state     = utility->GetPlayerStateByPlayer(character);
-                    auto        raw_name  = state->GetPlayerName();
-                    std::string name      = utf16_to_local_codepage(raw_name.Data, raw_name.NumElements);
+        if (userInput.empty()) {
+            continue;
+        }
 
-                    sprintf_s(hexuid, "%08x", static_cast<uint32_t>(uid.A));
+        auto input_utf16 = local_codepage_to_utf16(userInput);
+        auto command     = utf16_to_utf8(input_utf16.c_str(), input_utf16.size());
 
-                    if (kick_uid == std::string(hexuid)) {
-                        SDK::FText *reason = GetEmptyFText();
+        try {
+            auto reply = game_thread::post([&command, sdkContext] {
+                return execute_command(command, *sdkContext);
+            }).get();
 
-                        auto kicked = KickPlayer(world, &uid, reason);
+            auto reply_utf16 = utf8_to_utf16(reply);
 
-                        if (kicked) {
-                            spdlog::info("[CMD::Kick] player {} kicked", name);
-                        }
-                    }
-                }
-            }
-        } else {
-            spdlog::info("[CMD::???] Unknown command");
+            std::cout << utf16_to_local_codepage(reply_utf16.data(), reply_utf16.size());
+        } catch (std::exception const &e) {
+            spdlog::error("command failed: {}", e.what());
         }
     }
 }
-
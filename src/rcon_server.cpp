@@ -0,0 +1,393 @@
+#include "rcon_server.h"
+#include "admission.h"
+#include "game_thread.h"
+#include "metrics.h"
+#include "spdlog/spdlog.h"
+
+#include <boost/beast/core/bind_handler.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+namespace beast = boost::beast; // from <boost/beast.hpp>
+
+namespace {
+    // EXECCOMMAND and AUTH_RESPONSE share a value, the direction tells them apart
+    constexpr int32_t SERVERDATA_AUTH           = 3;
+    constexpr int32_t SERVERDATA_AUTH_RESPONSE  = 2;
+    constexpr int32_t SERVERDATA_EXECCOMMAND    = 2;
+    constexpr int32_t SERVERDATA_RESPONSE_VALUE = 0;
+
+    // size counts id, type, the body and its two terminating nulls, but not itself
+    constexpr size_t SizeFieldBytes  = 4;
+    constexpr size_t MinPacketSize   = 10;
+    constexpr size_t MaxRequestBody  = 4096;
+    constexpr size_t MaxResponseBody = 4096;
+
+    // the protocol is little endian, like every target of this loader
+    void append_int32(std::string &out, int32_t value) {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    int32_t read_int32(const char *data) {
+        int32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    void append_packet(std::string &out, int32_t id, int32_t type, std::string_view body) {
+        append_int32(out, static_cast<int32_t>(MinPacketSize + body.size()));
+        append_int32(out, id);
+        append_int32(out, type);
+        out.append(body);
+        out.append(2, '\0');
+    }
+
+    // append_reply - one RESPONSE_VALUE per MaxResponseBody bytes of body, never cut inside a UTF-8 sequence
+    void append_reply(std::string &out, int32_t id, std::string_view body) {
+        do {
+            size_t length = std::min(body.size(), MaxResponseBody);
+
+            while (length < body.size() && length > 0 && (static_cast<unsigned char>(body[length]) & 0xC0) == 0x80) {
+                length--;
+            }
+            if (length == 0) {
+                length = std::min(body.size(), MaxResponseBody);
+            }
+
+            append_packet(out, id, SERVERDATA_RESPONSE_VALUE, body.substr(0, length));
+            body.remove_prefix(length);
+        } while (!body.empty());
+    }
+
+    // password_matches - runs over the whole attempt whatever it has in common with the password, so timing
+    // doesn't tell how much of a guess was right
+    bool password_matches(std::string_view attempt, std::string_view password) {
+        unsigned char difference = attempt.size() != password.size();
+
+        for (size_t i = 0; i < attempt.size(); i++) {
+            difference |= static_cast<unsigned char>(attempt[i] ^ (password.empty() ? 0 : password[i % password.size()]));
+        }
+
+        return difference == 0;
+    }
+
+    std::string_view trim_line(std::string_view text) {
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r' || text.back() == ' ')) {
+            text.remove_suffix(1);
+        }
+        while (!text.empty() && text.front() == ' ') {
+            text.remove_prefix(1);
+        }
+        return text;
+    }
+
+    // One RCON client. Everything runs on the connection's strand.
+    class RconSession : public std::enable_shared_from_this<RconSession> {
+        public:
+            RconSession(tcp::socket &&in_socket, std::shared_ptr<const RconServerOptions> in_options, std::shared_ptr<SDKContext> in_sdkContext)
+                : socket(std::move(in_socket)), options(std::move(in_options)), sdkContext(std::move(in_sdkContext)) {
+                metrics::rcon_connections.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            ~RconSession() {
+                metrics::rcon_connections.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            void start() {
+                beast::error_code ec;
+                auto              endpoint = socket.remote_endpoint(ec);
+
+                address = ec ? std::string("[UNK]") : endpoint.address().to_string();
+                remote  = ec ? address : address + ":" + std::to_string(endpoint.port());
+                spdlog::debug("RCON connection from {}", remote);
+
+                net::dispatch(socket.get_executor(), beast::bind_front_handler(&RconSession::do_read, shared_from_this()));
+            }
+
+        private:
+            // a reply in request order, ready once its packets are encoded
+            struct Pending {
+                    bool        ready = false;
+                    std::string packets;
+            };
+
+            void do_read() {
+                reading = true;
+                socket.async_read_some(read_buffer.prepare(MinPacketSize + MaxRequestBody), beast::bind_front_handler(&RconSession::on_read, shared_from_this()));
+            }
+
+            void on_read(beast::error_code ec, std::size_t bytes) {
+                reading = false;
+
+                if (ec) {
+                    if (ec != net::error::eof && ec != net::error::operation_aborted) {
+                        spdlog::debug("RCON read from {} failed: {}", remote, ec.message());
+                    }
+
+                    // a client may send its last commands and half close, they are still answered
+                    closing = true;
+                    do_write();
+                    return;
+                }
+
+                read_buffer.commit(bytes);
+
+                if (!handle_packets()) {
+                    close();
+                    return;
+                }
+
+                if (!closing && pending.size() < options->pipeline_limit) {
+                    do_read();
+                }
+            }
+
+            // handle_packets - every complete packet in the buffer, false on a malformed one
+            bool handle_packets() {
+                while (!closing && read_buffer.size() >= SizeFieldBytes) {
+                    auto data = static_cast<const char *>(read_buffer.data().data());
+                    auto size = read_int32(data);
+
+                    if (size < static_cast<int32_t>(MinPacketSize) || size > static_cast<int32_t>(MinPacketSize + MaxRequestBody)) {
+                        spdlog::debug("RCON packet of {} bytes from {}, closing", size, remote);
+                        return false;
+                    }
+
+                    if (read_buffer.size() < SizeFieldBytes + size) {
+                        return true;
+                    }
+
+                    auto id   = read_int32(data + 4);
+                    auto type = read_int32(data + 8);
+                    auto body = std::string_view(data + 12, size - 8);
+
+                    // clients disagree on one or two terminating nulls, the body ends at the first
+                    body = body.substr(0, body.find('\0'));
+
+                    handle_packet(id, type, body);
+                    read_buffer.consume(SizeFieldBytes + size);
+                }
+
+                return true;
+            }
+
+            void handle_packet(int32_t id, int32_t type, std::string_view body) {
+                std::string reply;
+
+                if (type == SERVERDATA_AUTH) {
+                    // every attempt costs a write token, guessing is as slow as flooding commands
+                    auto admission = admission::admit(address, {}, RequestCost::write);
+
+                    authenticated = admission && password_matches(body, options->password);
+
+                    // srcds sends an empty RESPONSE_VALUE ahead of the AUTH_RESPONSE, some clients wait for it
+                    append_packet(reply, id, SERVERDATA_RESPONSE_VALUE, {});
+                    append_packet(reply, authenticated ? id : -1, SERVERDATA_AUTH_RESPONSE, {});
+
+                    if (!admission) {
+                        spdlog::warn("RCON authentication from {} rate limited", remote);
+                        closing = true;
+                    } else if (!authenticated) {
+                        spdlog::warn("RCON authentication from {} failed", remote);
+                        closing = true;
+                    }
+
+                    fulfill(reserve(), std::move(reply));
+                    return;
+                }
+
+                if (!authenticated) {
+                    append_packet(reply, -1, SERVERDATA_AUTH_RESPONSE, {});
+                    closing = true;
+
+                    fulfill(reserve(), std::move(reply));
+                    return;
+                }
+
+                if (type == SERVERDATA_RESPONSE_VALUE) {
+                    // the end of reply marker, written after every packet of the commands before it
+                    append_packet(reply, id, SERVERDATA_RESPONSE_VALUE, {});
+                    fulfill(reserve(), std::move(reply));
+                    return;
+                }
+
+                if (type != SERVERDATA_EXECCOMMAND) {
+                    append_reply(reply, id, "Unknown request type\n");
+                    fulfill(reserve(), std::move(reply));
+                    return;
+                }
+
+                execute(id, trim_line(body));
+            }
+
+            void execute(int32_t id, std::string_view text) {
+                auto        slot = reserve();
+                std::string error;
+
+                // checked here, only commands that can run cost a game thread task
+                auto command = parse_command(text, &error);
+                if (!command) {
+                    std::string reply;
+                    append_reply(reply, id, error + "\n");
+                    fulfill(slot, std::move(reply));
+                    return;
+                }
+
+                // one bucket per address, shared with the HTTP API
+                if (auto admission = admission::admit(address, {}, RequestCost::write); !admission) {
+                    std::string reply;
+                    append_reply(reply, id, admission.never ? std::string("Refused, the write rate limit allows no commands\n") : fmt::format("Too Many Requests, retry in {} ms\n", admission.retry_after.count()));
+                    fulfill(slot, std::move(reply));
+                    return;
+                }
+
+                auto run = [sdkContext = sdkContext, command = std::move(*command)] {
+                    PlayerIndex players(*sdkContext);
+                    return run_command(command, *sdkContext, players);
+                };
+
+                game_thread::async_post(std::move(run), net::bind_executor(socket.get_executor(), [self = shared_from_this(), slot, id](std::exception_ptr error, std::string result) {
+                    if (error) {
+                        try {
+                            std::rethrow_exception(error);
+                        } catch (std::exception const &e) {
+                            result = std::string("Command failed: ") + e.what() + "\n";
+                        } catch (...) {
+                            result = "Command failed\n";
+                        }
+                    }
+
+                    std::string reply;
+                    append_reply(reply, id, result);
+                    self->fulfill(slot, std::move(reply));
+                }));
+            }
+
+            uint64_t reserve() {
+                pending.emplace_back();
+                return next_slot++;
+            }
+
+            void fulfill(uint64_t slot, std::string &&packets) {
+                auto &entry   = pending[slot - first_slot];
+                entry.ready   = true;
+                entry.packets = std::move(packets);
+
+                do_write();
+            }
+
+            void do_write() {
+                if (writing || failed) {
+                    return;
+                }
+
+                if (pending.empty() || !pending.front().ready) {
+                    if (pending.empty() && closing) {
+                        close();
+                    }
+                    return;
+                }
+
+                // every reply ready at the front goes out in one write
+                write_buffer.clear();
+
+                while (!pending.empty() && pending.front().ready) {
+                    write_buffer += pending.front().packets;
+                    pending.pop_front();
+                    first_slot++;
+                }
+
+                writing = true;
+                net::async_write(socket, net::buffer(write_buffer), beast::bind_front_handler(&RconSession::on_write, shared_from_this()));
+            }
+
+            void on_write(beast::error_code ec, std::size_t) {
+                writing = false;
+
+                if (ec) {
+                    spdlog::debug("RCON write to {} failed: {}", remote, ec.message());
+                    close();
+                    return;
+                }
+
+                if (!reading && !closing && pending.size() < options->pipeline_limit) {
+                    do_read();
+                }
+
+                do_write();
+            }
+
+            // close - replies still running on the game thread are dropped when they come back
+            void close() {
+                if (failed) {
+                    return;
+                }
+
+                failed = true;
+
+                beast::error_code ec;
+                socket.shutdown(tcp::socket::shutdown_both, ec);
+                socket.close(ec);
+            }
+
+            tcp::socket                              socket;
+            std::shared_ptr<const RconServerOptions> options;
+            std::shared_ptr<SDKContext>              sdkContext;
+            std::string                              address; // without the port, what admission counts by
+            std::string                              remote;
+            beast::flat_buffer                       read_buffer;
+            std::string                              write_buffer;
+            std::deque<Pending>                      pending;
+            uint64_t                                 first_slot    = 0; // slot of pending.front()
+            uint64_t                                 next_slot     = 0;
+            bool                                     authenticated = false;
+            bool                                     reading       = false;
+            bool                                     writing       = false;
+            bool                                     closing       = false; // no more reads, close once every reply is written
+            bool                                     failed        = false;
+    };
+} // namespace
+
+RconServer::RconServer(net::io_context &in_ioc, RconServerOptions in_options, std::shared_ptr<SDKContext> in_sdkContext)
+    : ioc(in_ioc), options(std::make_shared<const RconServerOptions>(std::move(in_options))), sdkContext(std::move(in_sdkContext)), acceptor(net::make_strand(in_ioc)) {}
+
+RconServer::~RconServer() {
+    stop();
+}
+
+void RconServer::start() {
+    tcp::endpoint endpoint { net::ip::make_address(options->address), options->port };
+
+    acceptor.open(endpoint.protocol());
+    acceptor.set_option(net::socket_base::reuse_address(true));
+    acceptor.bind(endpoint);
+    acceptor.listen(net::socket_base::max_listen_connections);
+
+    do_accept();
+
+    spdlog::info("RCON server is running at {}:{} ...", options->address, options->port);
+}
+
+void RconServer::stop() {
+    beast::error_code ec;
+    acceptor.close(ec);
+}
+
+void RconServer::do_accept() {
+    // every connection gets its own strand, so a session never needs a lock
+    acceptor.async_accept(net::make_strand(ioc), [this](beast::error_code ec, tcp::socket socket) {
+        if (!ec) {
+            socket.set_option(tcp::no_delay(true), ec);
+            std::make_shared<RconSession>(std::move(socket), options, sdkContext)->start();
+        } else if (ec == net::error::operation_aborted) {
+            return;
+        } else {
+            spdlog::error("Error accepting RCON connection: {}", ec.message());
+        }
+
+        do_accept();
+    });
+}
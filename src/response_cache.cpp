@@ -0,0 +1,163 @@
+#include "response_cache.h"
+#include "spdlog/spdlog.h"
+
+#include <mutex>
+
+namespace {
+    // FNV-1a, enough to tell two bodies of the same route apart
+    uint64_t hash_body(std::string_view body) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+
+        for (unsigned char c : body) {
+            hash ^= c;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    // etag_listed - If-None-Match is "*" or a comma separated list of tags, weak ones compare by their opaque part
+    bool etag_listed(std::string_view header, std::string_view etag) {
+        if (etag.starts_with("W/")) {
+            etag.remove_prefix(2);
+        }
+
+        while (!header.empty()) {
+            auto comma = header.find(',');
+            auto tag   = header.substr(0, comma);
+
+            header = comma == std::string_view::npos ? std::string_view() : header.substr(comma + 1);
+
+            while (!tag.empty() && tag.front() == ' ') {
+                tag.remove_prefix(1);
+            }
+            while (!tag.empty() && tag.back() == ' ') {
+                tag.remove_suffix(1);
+            }
+            if (tag.starts_with("W/")) {
+                tag.remove_prefix(2);
+            }
+
+            if (tag == "*" || tag == etag) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+} // namespace
+
+const std::string &CachedResponse::encoded(ContentCoding coding) const {
+    if (coding == ContentCoding::identity) {
+        return body;
+    }
+
+    auto index = static_cast<size_t>(coding);
+
+    std::call_once(encode_once[index], [this, coding, index] {
+        encoded_bodies[index] = http_compression::compress(body, coding);
+    });
+
+    return encoded_bodies[index];
+}
+
+std::string CachedResponse::encoded_etag(ContentCoding coding) const {
+    if (coding == ContentCoding::identity) {
+        return etag;
+    }
+
+    auto tag = std::string_view(etag).substr(0, etag.size() - 1);
+    return fmt::format("{}-{}\"", tag, http_compression::name(coding));
+}
+
+std::shared_ptr<const CachedResponse> ResponseCache::find(std::string_view key, uint64_t version, std::chrono::milliseconds ttl) const {
+    std::shared_lock read_lock(lock);
+
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        return nullptr;
+    }
+
+    auto &entry = it->second;
+    if (entry->version != version || std::chrono::steady_clock::now() - entry->created >= ttl) {
+        return nullptr;
+    }
+
+    return entry;
+}
+
+std::shared_ptr<const CachedResponse> ResponseCache::store(std::string_view key, uint64_t version, std::string body, std::string_view content_type, std::string_view etag_basis) {
+    auto entry = std::make_shared<CachedResponse>();
+
+    entry->version      = version;
+    entry->created      = std::chrono::steady_clock::now();
+    entry->etag         = etag_basis.empty() ? fmt::format("\"{:016x}\"", hash_body(body)) : fmt::format("W/\"{:016x}\"", hash_body(etag_basis));
+    entry->body         = std::move(body);
+    entry->content_type = content_type;
+
+    std::unique_lock write_lock(lock);
+
+    // keys carry path parameters [/players/{uid}], drop entries of older versions before growing past the limit
+    if (entries.size() >= max_entries && !entries.contains(key)) {
+        std::erase_if(entries, [version](const auto &item) {
+            return item.second->version < version;
+        });
+
+        if (entries.size() >= max_entries) {
+            entries.clear();
+        }
+    }
+
+    if (auto it = entries.find(key); it != entries.end()) {
+        it->second = entry;
+    } else {
+        entries.emplace(key, entry);
+    }
+
+    return entry;
+}
+
+void ResponseCache::clear() {
+    std::unique_lock write_lock(lock);
+    entries.clear();
+}
+
+std::unique_ptr<HttpResponseWriter> cached_response_writer(const HttpRequest &request, std::shared_ptr<const CachedResponse> entry) {
+    auto negotiable = entry->body.size() >= http_compression::min_bytes();
+    auto coding     = negotiable ? accepted_coding(request) : ContentCoding::identity;
+    auto etag       = entry->encoded_etag(coding);
+
+    auto if_none_match = request[http::field::if_none_match];
+
+    if (!if_none_match.empty() && etag_listed(std::string_view(if_none_match.data(), if_none_match.size()), etag)) {
+        http::response<http::empty_body> response { http::status::not_modified, request.version() };
+        response.set(http::field::server, "Boost.Beast");
+        response.set(http::field::etag, etag);
+        response.set(http::field::cache_control, "no-cache");
+        if (negotiable) {
+            response.set(http::field::vary, "Accept-Encoding");
+        }
+        response.keep_alive(request.keep_alive());
+        return std::make_unique<HttpMessageWriter<http::empty_body>>(std::move(response));
+    }
+
+    auto &body = entry->encoded(coding);
+
+    http::response<http::span_body<const char>> response { http::status::ok, request.version() };
+    response.set(http::field::server, "Boost.Beast");
+    response.set(http::field::content_type, entry->content_type);
+    response.set(http::field::etag, etag);
+    // pollers revalidate every time, an unchanged body then costs a 304
+    response.set(http::field::cache_control, "no-cache");
+    if (negotiable) {
+        response.set(http::field::vary, "Accept-Encoding");
+    }
+    if (coding != ContentCoding::identity) {
+        auto name = http_compression::name(coding);
+        response.set(http::field::content_encoding, beast::string_view(name.data(), name.size()));
+    }
+    response.keep_alive(request.keep_alive());
+    response.body() = http::span_body<const char>::value_type(body.data(), body.size());
+    response.prepare_payload();
+
+    return std::make_unique<HttpSharedBodyWriter>(std::move(response), std::move(entry));
+}
@@ -13,6 +13,294 @@ void InitGObjects()
 	UObject::GObjects = reinterpret_cast<TUObjectArray*>(uintptr_t(GetImageBaseOffset()) + Offsets::GObjects);
 }		
 
+void FParallelFor::StartWorkers()
+{
+	// leave half of the cores to the game
+	const int32 NumThreads = std::max(1, static_cast<int32>(std::thread::hardware_concurrency() / 2));
+
+	for (int32 i = 0; i < NumThreads; i++)
+		Workers.emplace_back(WorkerLoop).detach();
+}
+
+int32 FParallelFor::NumWorkers()
+{
+	std::call_once(WorkersStarted, StartWorkers);
+
+	return static_cast<int32>(Workers.size());
+}
+
+void FParallelFor::Run(int32 NumTasks, const std::function<void(int32)>& Task)
+{
+	if (NumTasks <= 0)
+		return;
+
+	// the outer Run holds RunLock and the workers, waiting for either would never end
+	if (WorkDepth > 0)
+	{
+		for (int32 i = 0; i < NumTasks; i++)
+			Task(i);
+
+		return;
+	}
+
+	std::call_once(WorkersStarted, StartWorkers);
+	std::scoped_lock RunGuard(RunLock);
+
+	FJob Job{ &Task, NumTasks };
+
+	// Job lives on this stack, no worker may still hold it when Run leaves, whichever way it does
+	struct FWaitForWorkers
+	{
+		FJob& Job;
+
+		~FWaitForWorkers()
+		{
+			std::unique_lock Guard(Lock);
+			CurrentJob = nullptr;
+			Finished.wait(Guard, [this] { return Job.NumActive == 0; });
+		}
+	};
+
+	{
+		FWaitForWorkers WaitForWorkers{ Job };
+
+		{
+			std::scoped_lock Guard(Lock);
+			CurrentJob = &Job;
+			Generation++;
+		}
+
+		WakeUp.notify_all();
+
+		Work(Job);
+	}
+
+	if (Job.Error)
+		std::rethrow_exception(Job.Error);
+}
+
+void FParallelFor::WorkerLoop()
+{
+	uint64 SeenGeneration = 0;
+
+	while (true)
+	{
+		FJob* Job = nullptr;
+
+		{
+			std::unique_lock Guard(Lock);
+			WakeUp.wait(Guard, [&SeenGeneration] { return Generation != SeenGeneration; });
+
+			SeenGeneration = Generation;
+			Job            = CurrentJob;
+
+			if (!Job)
+				continue;
+
+			Job->NumActive++;
+		}
+
+		Work(*Job);
+
+		std::scoped_lock Guard(Lock);
+
+		if (--Job->NumActive == 0)
+			Finished.notify_all();
+	}
+}
+
+void FParallelFor::Work(FJob& Job)
+{
+	struct FDepthGuard
+	{
+		FDepthGuard() { WorkDepth++; }
+		~FDepthGuard() { WorkDepth--; }
+	} DepthGuard;
+
+	try
+	{
+		for (int32 Task = Job.NextTask.fetch_add(1); Task < Job.NumTasks; Task = Job.NextTask.fetch_add(1))
+			(*Job.Task)(Task);
+	}
+	catch (...)
+	{
+		// an exception must not end a worker thread [std::terminate], the caller of Run gets it
+		Job.NextTask = Job.NumTasks;
+
+		std::scoped_lock Guard(Lock);
+
+		if (!Job.Error)
+			Job.Error = std::current_exception();
+	}
+}
+
+static void AppendUtf8(std::string& Out, const wchar_t* Data, int32 Length)
+{
+	for (int32 i = 0; i < Length; i++)
+	{
+		uint32 CodePoint = static_cast<uint16>(Data[i]);
+
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && i + 1 < Length)
+		{
+			const uint32 Low = static_cast<uint16>(Data[i + 1]);
+
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+				i++;
+			}
+		}
+
+		if (CodePoint < 0x80)
+		{
+			Out += static_cast<char>(CodePoint);
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out += static_cast<char>(0xC0 | (CodePoint >> 6));
+			Out += static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out += static_cast<char>(0xE0 | (CodePoint >> 12));
+			Out += static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Out += static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+		else
+		{
+			Out += static_cast<char>(0xF0 | (CodePoint >> 18));
+			Out += static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F));
+			Out += static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+			Out += static_cast<char>(0x80 | (CodePoint & 0x3F));
+		}
+	}
+}
+
+std::string FNameCache::Decode(int32 ComparisonIndex)
+{
+	thread_local FString TempString(1024);
+	static void (*AppendString)(const FName*, FString&) = nullptr;
+
+	if (!AppendString)
+		AppendString = reinterpret_cast<void (*)(const FName*, FString&)>(uintptr_t(GetImageBaseOffset()) + Offsets::AppendString);
+
+	// Number 0 keeps the engine from appending a suffix, we only cache the entry itself
+	const FName EntryName{ ComparisonIndex, 0 };
+
+	AppendString(&EntryName, TempString);
+
+	int32 Length = 0;
+
+	while (Length < TempString.Num() && TempString[Length] != L'\0')
+		Length++;
+
+	std::string OutputString;
+	OutputString.reserve(Length);
+
+	AppendUtf8(OutputString, TempString.Data, Length);
+	TempString.ResetNum();
+
+	return OutputString;
+}
+
+std::string_view FNameCache::GetEntry(int32 ComparisonIndex)
+{
+	FShard& Shard = GetShard(ComparisonIndex);
+
+	{
+		std::shared_lock ReadLock(Shard.Lock);
+
+		if (auto It = Shard.Entries.find(ComparisonIndex); It != Shard.Entries.end())
+			return It->second;
+	}
+
+	// decode outside of the lock, AppendString takes the engine's own name pool lock
+	const std::string Decoded = Decode(ComparisonIndex);
+
+	std::string_view Entry;
+
+	{
+		std::unique_lock WriteLock(Shard.Lock);
+
+		auto [It, bInserted] = Shard.Entries.try_emplace(ComparisonIndex);
+
+		if (!bInserted)
+			return It->second;
+
+		auto& Storage = Shard.Storage.emplace_back(std::make_unique<char[]>(Decoded.size() + 1));
+		std::memcpy(Storage.get(), Decoded.c_str(), Decoded.size() + 1);
+
+		Entry = It->second = std::string_view(Storage.get(), Decoded.size());
+	}
+
+	FShard& IndexShard = GetShard(static_cast<uint32>(std::hash<std::string_view>{}(Entry)));
+
+	std::unique_lock WriteLock(IndexShard.Lock);
+	IndexShard.Indices.try_emplace(Entry, ComparisonIndex);
+
+	return Entry;
+}
+
+bool FNameCache::FindComparisonIndex(std::string_view Entry, int32& OutComparisonIndex)
+{
+	FShard& IndexShard = GetShard(static_cast<uint32>(std::hash<std::string_view>{}(Entry)));
+
+	std::shared_lock ReadLock(IndexShard.Lock);
+
+	auto It = IndexShard.Indices.find(Entry);
+
+	if (It == IndexShard.Indices.end())
+		return false;
+
+	OutComparisonIndex = It->second;
+
+	return true;
+}
+
+int32 FNameCache::Num()
+{
+	int32 Count = 0;
+
+	for (FShard& Shard : Shards)
+	{
+		std::shared_lock ReadLock(Shard.Lock);
+		Count += static_cast<int32>(Shard.Entries.size());
+	}
+
+	return Count;
+}
+
+static constexpr auto MakeCrcTableDeprecated()
+{
+	std::array<uint32, 256> Table{};
+
+	for (uint32 i = 0; i < 256; i++)
+	{
+		uint32 Crc = i << 24;
+
+		for (int32 Bit = 0; Bit < 8; Bit++)
+			Crc = Crc & 0x80000000 ? (Crc << 1) ^ 0x04C11DB7 : Crc << 1;
+
+		Table[i] = Crc;
+	}
+
+	return Table;
+}
+
+static constexpr auto CrcTableDeprecated = MakeCrcTableDeprecated();
+
+uint32 GetTypeHash(const FGuid& Guid)
+{
+	const uint8* Data = reinterpret_cast<const uint8*>(&Guid);
+
+	uint32 Crc = ~0u;
+
+	for (int32 i = 0; i < sizeof(FGuid); i++)
+		Crc = (Crc << 8) ^ CrcTableDeprecated[(Crc >> 24) ^ Data[i]];
+
+	return ~Crc;
+}
+
 FString FSoftObjectPtr::GetSubPathString()
 {
 	return ObjectID.SubPathString;
@@ -34,33 +322,513 @@ SoftObjectPath& FSoftObjectPtr::GetObjectPath()
 void Dummy() { FSoftObjectPtr().GetObjectPath(); }
 
 
+FWeakObjectPtr FWeakObjectPtr::FromObject(const UObject* Object)
+{
+	FWeakObjectPtr Ptr;
+	Ptr.ObjectIndex = 0;
+	Ptr.ObjectSerialNumber = 0;
+
+	FUObjectItem* Item = Object ? UObject::GObjects->GetItemByIndex(Object->Index) : nullptr;
+
+	if (!Item || Item->Object != Object)
+		return Ptr;
+
+	int32 SerialNumber = std::atomic_ref<int32>(Item->SerialNumber).load();
+
+	// FUObjectArray::AllocateSerialNumber: next value of the engine's counter, whoever sets the item first wins
+	if (SerialNumber == 0)
+	{
+		if (!Offsets::MasterSerialNumber)
+			return Ptr;
+
+		int32& MasterSerialNumber = *reinterpret_cast<int32*>(uintptr_t(GetImageBaseOffset()) + Offsets::MasterSerialNumber);
+
+		SerialNumber = std::atomic_ref<int32>(MasterSerialNumber).fetch_add(1) + 1;
+
+		int32 Expected = 0;
+		if (!std::atomic_ref<int32>(Item->SerialNumber).compare_exchange_strong(Expected, SerialNumber))
+			SerialNumber = Expected;
+	}
+
+	Ptr.ObjectIndex = Object->Index;
+	Ptr.ObjectSerialNumber = SerialNumber;
+
+	return Ptr;
+}
+
+int32 FWeakObjectPtr::ResolveBatch(const FWeakObjectPtr* Ptrs, int32 Count, UObject** OutObjects)
+{
+	constexpr int32 PrefetchDistance = 8;
+
+	FUObjectItem** Chunks = UObject::GObjects->GetDecrytedObjPtr();
+	const int32 NumElements = UObject::GObjects->Num();
+
+	int32 NumAlive = 0;
+
+	// handles are usually scattered over the whole object array, fetch items ahead of the compare
+	for (int32 i = 0; i < Count; i++)
+	{
+		if (i + PrefetchDistance < Count)
+		{
+			const int32 Ahead = Ptrs[i + PrefetchDistance].ObjectIndex;
+
+			if (Ahead >= 0 && Ahead < NumElements)
+				_mm_prefetch(reinterpret_cast<const char*>(&Chunks[Ahead / TUObjectArray::ElementsPerChunk][Ahead % TUObjectArray::ElementsPerChunk]), _MM_HINT_T0);
+		}
+
+		OutObjects[i] = Ptrs[i].Get();
+
+		if (OutObjects[i])
+			NumAlive++;
+	}
+
+	return NumAlive;
+}
+
 class UObject* FWeakObjectPtr::Get() const
 {
-	return UObject::GObjects->GetByIndex(ObjectIndex);
+	// serial 0 is never handed out, it marks a null or never-assigned handle
+	if (ObjectSerialNumber == 0)
+		return nullptr;
+
+	FUObjectItem* Item = UObject::GObjects->GetItemByIndex(ObjectIndex);
+
+	if (!Item || Item->SerialNumber != ObjectSerialNumber)
+		return nullptr;
+
+	return Item->Object;
 }
 
 class UObject* FWeakObjectPtr::operator->() const
 {
-	return UObject::GObjects->GetByIndex(ObjectIndex);
+	return Get();
 }
 
 bool FWeakObjectPtr::operator==(const FWeakObjectPtr& Other) const
 {
-	return ObjectIndex == Other.ObjectIndex;
+	return ObjectIndex == Other.ObjectIndex && ObjectSerialNumber == Other.ObjectSerialNumber;
 }
 bool FWeakObjectPtr::operator!=(const FWeakObjectPtr& Other) const
 {
-	return ObjectIndex != Other.ObjectIndex;
+	return !(*this == Other);
 }
 
 bool FWeakObjectPtr::operator==(const class UObject* Other) const
 {
-	return ObjectIndex == Other->Index;
+	return Get() == Other;
 }
 bool FWeakObjectPtr::operator!=(const class UObject* Other) const
 {
-	return ObjectIndex != Other->Index;
+	return !(*this == Other);
+}
+
+
+static uint64 ObjectNameKey(const UObject* Object)
+{
+	return (uint64(uint32(Object->Name.ComparisonIndex)) << 32) | uint32(Object->Name.Number);
+}
+
+void FObjectNameIndex::Build()
+{
+	std::unique_lock WriteLock(Lock);
+
+	const int32 Num = UObject::GObjects->Num();
+
+	Buckets.clear();
+	BucketsByName.clear();
+	Slots.assign(Num, nullptr);
+	SlotBuckets.assign(Num, nullptr);
+	SlotNames.assign(Num, 0);
+
+	for (int i = 0; i < Num; i++)
+	{
+		if (UObject* Object = UObject::GObjects->GetByIndex(i))
+			IndexSlot(i, Object);
+	}
+
+	bBuilt = true;
+}
+
+void FObjectNameIndex::Sync()
+{
+	std::vector<int32> Changed;
+	int32              Num = 0;
+
+	{
+		std::shared_lock ReadLock(Lock);
+
+		Num = UObject::GObjects->Num();
+
+		for (int i = 0; i < Num; i++)
+		{
+			if (i >= static_cast<int32>(Slots.size()) || SlotChanged(i, UObject::GObjects->GetByIndex(i)))
+				Changed.push_back(i);
+		}
+	}
+
+	if (Changed.empty())
+		return;
+
+	std::unique_lock WriteLock(Lock);
+
+	if (Slots.size() < Num)
+	{
+		Slots.resize(Num, nullptr);
+		SlotBuckets.resize(Num, nullptr);
+		SlotNames.resize(Num, 0);
+	}
+
+	// another Sync may have been here in between, or the slot changed again
+	for (int32 i : Changed)
+	{
+		UObject* Object = UObject::GObjects->GetByIndex(i);
+
+		if (!SlotChanged(i, Object))
+			continue;
+
+		UnindexSlot(i);
+
+		if (Object)
+			IndexSlot(i, Object);
+	}
+}
+
+bool FObjectNameIndex::SlotChanged(int32 Index, UObject* Object)
+{
+	return Object != Slots[Index] || (Object && ObjectNameKey(Object) != SlotNames[Index]);
+}
+
+UObject* FObjectNameIndex::FindByName(std::string_view Name, EClassCastFlags RequiredType)
+{
+	return Find(Name, {}, RequiredType);
+}
+
+UObject* FObjectNameIndex::FindByFullName(std::string_view FullName, EClassCastFlags RequiredType)
+{
+	// "Class Package.Outer.Name" -> "Name"
+	const size_t Pos = FullName.find_last_of(" .");
+
+	return Find(Pos == std::string_view::npos ? FullName : FullName.substr(Pos + 1), FullName, RequiredType);
+}
+
+int32 FObjectNameIndex::NumIndexed()
+{
+	std::shared_lock ReadLock(Lock);
+
+	return static_cast<int32>(Slots.size());
+}
+
+UObject* FObjectNameIndex::Find(std::string_view Name, std::string_view FullName, EClassCastFlags RequiredType)
+{
+	if (!bBuilt)
+		Build();
+
+	{
+		std::shared_lock ReadLock(Lock);
+
+		if (UObject* Object = FindLocked(Name, FullName, RequiredType))
+			return Object;
+	}
+
+	// Either it doesn't exist or it was created (or its slot reused) after the last sync. Sync only takes the
+	// exclusive lock when a slot changed, a lookup of something that doesn't exist [optional classes] stays shared.
+	Sync();
+
+	std::shared_lock ReadLock(Lock);
+
+	return FindLocked(Name, FullName, RequiredType);
+}
+
+UObject* FObjectNameIndex::FindLocked(std::string_view Name, std::string_view FullName, EClassCastFlags RequiredType)
+{
+	auto It = Buckets.find(Name);
+
+	if (It == Buckets.end())
+		return nullptr;
+
+	for (int32 Index : It->second)
+	{
+		UObject* Object = UObject::GObjects->GetByIndex(Index);
+
+		// slot was freed, reused or renamed since it was indexed, Sync() will move it to the right bucket
+		if (!Object || Object != Slots[Index] || ObjectNameKey(Object) != SlotNames[Index])
+			continue;
+
+		if (!Object->HasTypeFlag(RequiredType))
+			continue;
+
+		if (!FullName.empty() && !Object->IsFullName(FullName))
+			continue;
+
+		return Object;
+	}
+
+	return nullptr;
+}
+
+void FObjectNameIndex::IndexSlot(int32 Index, UObject* Object)
+{
+	const uint64 NameKey = ObjectNameKey(Object);
+
+	FBucket* Bucket = nullptr;
+
+	if (auto It = BucketsByName.find(NameKey); It != BucketsByName.end())
+	{
+		Bucket = It->second;
+	}
+	else
+	{
+		// first object with this FName, the only place a name gets decoded
+		Bucket = &Buckets[Object->Name.ToString()];
+		BucketsByName.emplace(NameKey, Bucket);
+	}
+
+	// keep buckets sorted so lookups return the lowest index, like the linear scan did
+	if (Bucket->empty() || Bucket->back() < Index)
+		Bucket->push_back(Index);
+	else
+		Bucket->insert(std::lower_bound(Bucket->begin(), Bucket->end(), Index), Index);
+
+	Slots[Index]       = Object;
+	SlotBuckets[Index] = Bucket;
+	SlotNames[Index]   = NameKey;
+}
+
+void FObjectNameIndex::UnindexSlot(int32 Index)
+{
+	if (FBucket* Bucket = SlotBuckets[Index])
+	{
+		auto It = std::lower_bound(Bucket->begin(), Bucket->end(), Index);
+
+		if (It != Bucket->end() && *It == Index)
+			Bucket->erase(It);
+	}
+
+	Slots[Index]       = nullptr;
+	SlotBuckets[Index] = nullptr;
+	SlotNames[Index]   = 0;
+}
+
+
+void FClassHierarchy::Build()
+{
+	std::scoped_lock Guard(BuildLock);
+
+	const int32 Num = UObject::GObjects->Num();
+
+	auto Table = std::make_unique<FTable>();
+	Table->Nodes.resize(Num);
+
+	std::vector<UClass*> Classes;
+
+	for (int i = 0; i < Num; i++)
+	{
+		UObject* Object = UObject::GObjects->GetByIndex(i);
+
+		if (!Object || !Object->Class || !Object->HasTypeFlag(EClassCastFlags::Class))
+			continue;
+
+		Classes.push_back(static_cast<UClass*>(Object));
+		Table->Nodes[i].Class = static_cast<UClass*>(Object);
+	}
+
+	// children as intrusive lists over object indices, classes without a known super become roots
+	std::vector<int32> FirstChild(Num, -1);
+	std::vector<int32> NextSibling(Num, -1);
+	std::vector<int32> Roots;
+
+	for (UClass* Class : Classes)
+	{
+		const UStruct* Super = Class->Super;
+
+		if (Super && Super->Index >= 0 && Super->Index < Num && Table->Nodes[Super->Index].Class == Super)
+		{
+			NextSibling[Class->Index] = FirstChild[Super->Index];
+			FirstChild[Super->Index] = Class->Index;
+		}
+		else
+		{
+			Roots.push_back(Class->Index);
+		}
+	}
+
+	int32 Counter = 0;
+	std::vector<std::pair<int32, bool>> Stack;
+
+	for (int32 Root : Roots)
+	{
+		Table->Nodes[Root].Depth = 0;
+		Stack.emplace_back(Root, false);
+
+		while (!Stack.empty())
+		{
+			auto [Index, bLeaving] = Stack.back();
+			Stack.pop_back();
+
+			FNode& Node = Table->Nodes[Index];
+
+			if (bLeaving)
+			{
+				Node.Exit = Counter;
+				continue;
+			}
+
+			Node.Enter = Counter++;
+			Stack.emplace_back(Index, true);
+
+			for (int32 Child = FirstChild[Index]; Child != -1; Child = NextSibling[Child])
+			{
+				Table->Nodes[Child].Depth = Node.Depth + 1;
+				Stack.emplace_back(Child, false);
+			}
+		}
+	}
+
+	Table->NumClasses = static_cast<int32>(Classes.size());
+
+	Current.store(Table.get(), std::memory_order_release);
+	Tables.push_back(std::move(Table));
+}
+
+const FClassHierarchy::FNode* FClassHierarchy::FindNode(const FTable* Table, const UClass* Class)
+{
+	const int32 Index = Class->Index;
+
+	if (Index < 0 || Index >= static_cast<int32>(Table->Nodes.size()))
+		return nullptr;
+
+	const FNode& Node = Table->Nodes[Index];
+
+	// the slot may hold a class created after the build
+	if (Node.Class != Class || Node.Enter < 0)
+		return nullptr;
+
+	return &Node;
 }
+
+bool FClassHierarchy::TryIsChildOf(const UClass* Class, const UClass* Base, bool& bOutResult)
+{
+	if (!Class || !Base)
+	{
+		bOutResult = false;
+		return true;
+	}
+
+	const FTable* Table = Current.load(std::memory_order_acquire);
+
+	if (!Table)
+		return false;
+
+	const FNode* ClassNode = FindNode(Table, Class);
+	const FNode* BaseNode  = FindNode(Table, Base);
+
+	if (!ClassNode || !BaseNode)
+		return false;
+
+	bOutResult = ClassNode->Enter >= BaseNode->Enter && ClassNode->Enter < BaseNode->Exit;
+
+	return true;
 }
 
+int32 FClassHierarchy::FilterByClass(const FUObjectItem* Items, int32 Count, const UClass* Base, UObject** OutObjects)
+{
+	const FTable* Table    = Current.load(std::memory_order_acquire);
+	const FNode*  BaseNode = Table && Base ? FindNode(Table, Base) : nullptr;
+
+	int32 NumFound = 0;
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		UObject* Object = Items[i].Object;
+
+		if (!Object || !Object->Class)
+			continue;
+
+		const FNode* Node = BaseNode ? FindNode(Table, Object->Class) : nullptr;
+
+		const bool bIsA = Node ? Node->Enter >= BaseNode->Enter && Node->Enter < BaseNode->Exit : Object->IsA(const_cast<UClass*>(Base));
+
+		if (bIsA)
+			OutObjects[NumFound++] = Object;
+	}
 
+	return NumFound;
+}
+
+int32 FClassHierarchy::NumClasses()
+{
+	const FTable* Table = Current.load(std::memory_order_acquire);
+
+	return Table ? Table->NumClasses : 0;
+}
+
+
+const FPropertyOffsets::FTable& FPropertyOffsets::GetTable(const UStruct* Struct)
+{
+	{
+		std::shared_lock ReadLock(Lock);
+
+		if (auto It = Tables.find(Struct); It != Tables.end())
+			return It->second;
+	}
+
+	FTable Table;
+
+	// most derived first, try_emplace keeps a shadowing property over the one it hides
+	for (const UStruct* Clss = Struct; Clss; Clss = Clss->Super)
+	{
+		for (FField* Field = Clss->ChildProperties; Field; Field = Field->Next)
+		{
+			if (!Field->Class || !(static_cast<EClassCastFlags>(Field->Class->CastFlags) & EClassCastFlags::Property))
+				continue;
+
+			const SDK::FProperty* Property = static_cast<const SDK::FProperty*>(Field);
+
+			Table.try_emplace(Field->Name.ToString(), FPropertyInfo{ Property->Offset, Property->ElementSize });
+		}
+	}
+
+	std::unique_lock WriteLock(Lock);
+
+	return Tables.try_emplace(Struct, std::move(Table)).first->second;
+}
+
+FPropertyOffsets::FPropertyInfo FPropertyOffsets::Find(const UStruct* Struct, std::string_view PropertyName)
+{
+	if (!Struct)
+		return {};
+
+	const FTable& Table = GetTable(Struct);
+
+	auto It = Table.find(PropertyName);
+
+	return It != Table.end() ? It->second : FPropertyInfo{};
+}
+
+bool FRuntimeFields::Resolve(std::vector<std::string>* OutFailed)
+{
+	bool bAllResolved = true;
+
+	for (FRuntimeField* Field = FRuntimeField::First; Field; Field = Field->Next)
+	{
+		const UStruct* Struct = UObject::FindObjectFast<UStruct>(Field->StructName, EClassCastFlags::Struct);
+
+		const FPropertyOffsets::FPropertyInfo Property = FPropertyOffsets::Find(Struct, Field->FieldName);
+
+		// a changed size means a changed type, the generated type would read garbage at any offset
+		if (Property.Offset < 0 || Property.ElementSize != Field->Size)
+		{
+			bAllResolved = false;
+
+			if (OutFailed)
+				OutFailed->emplace_back(std::string(Field->StructName) + "." + Field->FieldName);
+
+			continue;
+		}
+
+		Field->Offset = Property.Offset;
+	}
+
+	return bAllResolved;
+}
+}
@@ -22,28 +22,67 @@ namespace SDK
 
 	std::string UObject::GetFullName() const
 	{
-		if (Class)
+		std::string Name;
+		Name.reserve(128);
+
+		AppendFullName(Name);
+
+		return Name;
+	}
+
+	// Removes "Name" or "Name_N" from the end of Path, fails if it isn't there
+	static bool ConsumeNameSuffix(std::string_view& Path, const FName& Name)
+	{
+		TFixedPathBuffer<16> Number;
+		Name.AppendNumber(Number);
+
+		const std::string_view Plain  = Name.GetPlainNameView();
+		const std::string_view Suffix = Number.View();
+
+		if (!Path.ends_with(Suffix))
+			return false;
+
+		Path.remove_suffix(Suffix.size());
+
+		if (!Path.ends_with(Plain))
+			return false;
+
+		Path.remove_suffix(Plain.size());
+
+		return true;
+	}
+
+	bool UObject::IsFullName(std::string_view FullName) const
+	{
+		if (!Class)
+			return FullName == "None";
+
+		std::string_view Rest = FullName;
+
+		// innermost segment first, most candidates with the right short name differ in their outers
+		for (const UObject* Segment = this; Segment; Segment = Segment->Outer)
 		{
-			std::string Temp;
+			if (!ConsumeNameSuffix(Rest, Segment->Name))
+				return false;
 
-			for (UObject* NextOuter = Outer; NextOuter; NextOuter = NextOuter->Outer)
-			{
-				Temp = NextOuter->GetName() + "." + Temp;
-			}
+			const char Separator = Segment->Outer ? '.' : ' ';
 
-			std::string Name = Class->GetName();
-			Name += " ";
-			Name += Temp;
-			Name += GetName();
+			if (!Rest.ends_with(Separator))
+				return false;
 
-			return Name;
+			Rest.remove_suffix(1);
 		}
 
-		return "None";
+		return Class->Name.Equals(Rest);
 	}
 
 	bool UObject::IsA(class UClass* Clss) const
 	{
+		bool bIsA = false;
+
+		if (FClassHierarchy::TryIsChildOf(Class, Clss, bIsA))
+			return bIsA;
+
 		for (UStruct* Super = Class; Super; Super = Super->Super)
 		{
 			if (Super == Clss)
@@ -82,11 +121,11 @@ namespace SDK
 	{
 		for(UStruct* Clss = this; Clss; Clss = Clss->Super)
 		{
-			if (Clss->GetName() == ClassName)
+			if (Clss->Name.Equals(ClassName))
 			{
 				for (UField* Field = Clss->Children; Field; Field = Field->Next)
 				{
-					if(Field->HasTypeFlag(EClassCastFlags::Function) && Field->GetName() == FuncName)
+					if(Field->HasTypeFlag(EClassCastFlags::Function) && Field->Name.Equals(FuncName))
 					{
 						return static_cast<class UFunction*>(Field);
 					}	
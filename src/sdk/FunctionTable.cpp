@@ -0,0 +1,48 @@
+#pragma once
+
+
+#include "../SDK.hpp"
+
+namespace SDK
+{
+
+static const char* FunctionFullNames[] =
+{
+#define SDK_FUNCTION_FULL_NAME(Id, Package, Class, Function) "Function " Package "." Class "." Function,
+	SDK_FUNCTION_LIST(SDK_FUNCTION_FULL_NAME)
+#undef SDK_FUNCTION_FULL_NAME
+};
+
+static_assert(sizeof(FunctionFullNames) / sizeof(FunctionFullNames[0]) == static_cast<size_t>(EFunctionId::Num), "SDK_FUNCTION_LIST and EFunctionId are out of sync!");
+
+const char* FFunctionTable::GetFullName(EFunctionId Id)
+{
+	return FunctionFullNames[static_cast<uint16>(Id)];
+}
+
+bool FFunctionTable::Resolve(std::vector<std::string>* OutMissing)
+{
+	constexpr int32 NumFunctions = static_cast<int32>(EFunctionId::Num);
+
+	FParallelFor::Run(NumFunctions, [](int32 Index)
+	{
+		Functions[Index] = UObject::FindObject<UFunction>(FunctionFullNames[Index], EClassCastFlags::Function);
+	});
+
+	bool bAllResolved = true;
+
+	for (int32 i = 0; i < NumFunctions; i++)
+	{
+		if (Functions[i])
+			continue;
+
+		bAllResolved = false;
+
+		if (OutMissing)
+			OutMissing->emplace_back(FunctionFullNames[i]);
+	}
+
+	return bAllResolved;
+}
+
+}
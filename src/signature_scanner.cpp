@@ -0,0 +1,269 @@
+#include "signature_scanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <thread>
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+    #define SCANNER_TARGET_AVX2
+#else
+    #define SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+    // big enough to amortize the thread handoff, small enough that every pattern reads the chunk from L2
+    constexpr size_t scan_chunk_size = 1024 * 1024;
+
+    int hex_digit(char c) {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+
+    bool cpu_has_avx2() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+
+        __cpuidex(info, 7, 0);
+        return os_saves_ymm && (info[1] & (1 << 5));
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    inline bool matches_at(const uint8_t *at, const BytePattern &pattern) {
+        for (size_t i = 0; i < pattern.size(); i++) {
+            if ((at[i] & pattern.mask[i]) != pattern.bytes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // returns false once the pattern is known to be ambiguous, there is no point scanning further
+    inline bool record_match(const uint8_t *at, const BytePattern &pattern, PatternMatch &match) {
+        if (!matches_at(at, pattern)) {
+            return true;
+        }
+
+        if (!match.first) {
+            match.first = at;
+        }
+        return ++match.count < 2;
+    }
+
+    // Every scanner filters candidates on the first and last solid byte, then checks the full pattern.
+    // begin/end bound the match start, the caller guarantees end + pattern.size() - 1 <= the buffer size.
+
+    void scan_scalar(const uint8_t *data, size_t begin, size_t end, const BytePattern &pattern, PatternMatch &match) {
+        const uint8_t first = pattern.bytes[pattern.first_solid];
+        const uint8_t last  = pattern.bytes[pattern.last_solid];
+
+        for (size_t i = begin; i < end; i++) {
+            if (data[i + pattern.first_solid] == first && data[i + pattern.last_solid] == last) {
+                if (!record_match(data + i, pattern, match)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    void scan_sse2(const uint8_t *data, size_t begin, size_t end, const BytePattern &pattern, PatternMatch &match) {
+        const __m128i first = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_solid]));
+        const __m128i last  = _mm_set1_epi8(static_cast<char>(pattern.bytes[pattern.last_solid]));
+
+        size_t i = begin;
+        for (; i + 16 <= end; i += 16) {
+            const __m128i a    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + pattern.first_solid));
+            const __m128i b    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i + pattern.last_solid));
+            uint32_t      bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+
+            while (bits) {
+                if (!record_match(data + i + std::countr_zero(bits), pattern, match)) {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+
+        scan_scalar(data, i, end, pattern, match);
+    }
+
+    SCANNER_TARGET_AVX2 void scan_avx2(const uint8_t *data, size_t begin, size_t end, const BytePattern &pattern, PatternMatch &match) {
+        const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.first_solid]));
+        const __m256i last  = _mm256_set1_epi8(static_cast<char>(pattern.bytes[pattern.last_solid]));
+
+        size_t i = begin;
+        for (; i + 32 <= end; i += 32) {
+            const __m256i a    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + pattern.first_solid));
+            const __m256i b    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i + pattern.last_solid));
+            uint32_t      bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+
+            while (bits) {
+                if (!record_match(data + i + std::countr_zero(bits), pattern, match)) {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+
+        scan_scalar(data, i, end, pattern, match);
+    }
+
+    using ScanRangeType = void (*)(const uint8_t *, size_t, size_t, const BytePattern &, PatternMatch &);
+
+    ScanRangeType select_scanner() {
+        static const ScanRangeType scanner = cpu_has_avx2() ? scan_avx2 : scan_sse2;
+        return scanner;
+    }
+
+    void merge_match(PatternMatch &into, const PatternMatch &from) {
+        if (!from.count) {
+            return;
+        }
+
+        if (!into.first || from.first < into.first) {
+            into.first = from.first;
+        }
+        into.count = std::min<size_t>(into.count + from.count, 2);
+    }
+} // namespace
+
+std::optional<BytePattern> BytePattern::parse(std::string_view text) {
+    BytePattern pattern;
+    bool        has_solid = false;
+
+    for (size_t i = 0; i < text.size();) {
+        if (text[i] == ' ') {
+            i++;
+            continue;
+        }
+
+        if (text[i] == '?') {
+            i += (i + 1 < text.size() && text[i + 1] == '?') ? 2 : 1;
+            pattern.bytes.push_back(0);
+            pattern.mask.push_back(0);
+            continue;
+        }
+
+        if (i + 1 >= text.size() || hex_digit(text[i]) < 0 || hex_digit(text[i + 1]) < 0) {
+            return std::nullopt;
+        }
+
+        if (!has_solid) {
+            pattern.first_solid = pattern.bytes.size();
+            has_solid           = true;
+        }
+        pattern.last_solid = pattern.bytes.size();
+
+        pattern.bytes.push_back(static_cast<uint8_t>(hex_digit(text[i]) << 4 | hex_digit(text[i + 1])));
+        pattern.mask.push_back(0xFF);
+        i += 2;
+    }
+
+    if (!has_solid) {
+        return std::nullopt;
+    }
+
+    return pattern;
+}
+
+std::vector<PatternMatch> scan_patterns(const uint8_t *data, size_t size, const std::vector<BytePattern> &patterns) {
+    std::vector<PatternMatch> matches(patterns.size());
+
+    if (!data || !size || patterns.empty()) {
+        return matches;
+    }
+
+    const ScanRangeType scan_range  = select_scanner();
+    const size_t        num_chunks  = (size + scan_chunk_size - 1) / scan_chunk_size;
+    const size_t        num_threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, num_chunks);
+
+    std::atomic<size_t>                    next_chunk = 0;
+    std::vector<std::vector<PatternMatch>> thread_matches(num_threads, std::vector<PatternMatch>(patterns.size()));
+
+    auto worker = [&](size_t thread_index) {
+        auto &local = thread_matches[thread_index];
+
+        for (size_t chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+            const size_t chunk_begin = chunk * scan_chunk_size;
+            const size_t chunk_end   = std::min(chunk_begin + scan_chunk_size, size);
+
+            for (size_t i = 0; i < patterns.size(); i++) {
+                const BytePattern &pattern = patterns[i];
+
+                if (pattern.size() > size || local[i].count >= 2) {
+                    continue;
+                }
+
+                // a match starting in this chunk may end in the next one
+                const size_t end = std::min(chunk_end, size - pattern.size() + 1);
+                if (chunk_begin >= end) {
+                    continue;
+                }
+
+                PatternMatch chunk_match;
+                scan_range(data, chunk_begin, end, pattern, chunk_match);
+                merge_match(local[i], chunk_match);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+
+    for (size_t t = 1; t < num_threads; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (auto &local : thread_matches) {
+        for (size_t i = 0; i < patterns.size(); i++) {
+            merge_match(matches[i], local[i]);
+        }
+    }
+
+    return matches;
+}
+
+const uint8_t *find_pattern(const uint8_t *data, size_t size, const BytePattern &pattern) {
+    if (!data || pattern.size() == 0 || pattern.size() > size) {
+        return nullptr;
+    }
+
+    PatternMatch match;
+    const size_t end = size - pattern.size() + 1;
+
+    // only the first match is wanted, stop after the chunk that has one
+    for (size_t begin = 0; begin < end && !match.first; begin += scan_chunk_size) {
+        select_scanner()(data, begin, std::min(begin + scan_chunk_size, end), pattern, match);
+    }
+
+    return match.first;
+}
+
+bool scanner_uses_avx2() {
+    return select_scanner() == scan_avx2;
+}
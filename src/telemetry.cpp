@@ -0,0 +1,102 @@
+#include "telemetry.h"
+
+#include <array>
+#include <cstring>
+#include <mutex>
+
+namespace telemetry {
+    namespace {
+        // samples recently sent, a delta needs the client's last one; at 20 Hz this is a few seconds of history
+        constexpr size_t NumRemembered = 64;
+
+        struct Remembered {
+                uint64_t        sequence = 0;
+                TelemetrySample sample {};
+        };
+
+        std::mutex                             history_lock;
+        std::array<Remembered, NumRemembered> history;
+
+        void remember(uint64_t sequence, const TelemetrySample &sample) {
+            std::lock_guard lock(history_lock);
+
+            auto &entry = history[sequence % NumRemembered];
+            if (entry.sequence != sequence) {
+                entry.sequence = sequence;
+                entry.sample   = sample;
+            }
+        }
+
+        std::optional<TelemetrySample> recall(uint64_t sequence) {
+            std::lock_guard lock(history_lock);
+
+            auto &entry = history[sequence % NumRemembered];
+            if (sequence == 0 || entry.sequence != sequence) {
+                return std::nullopt;
+            }
+            return entry.sample;
+        }
+    } // namespace
+
+    TelemetrySample sample(const WorldSnapshot &snapshot) {
+        TelemetrySample sample {};
+
+        sample.server_frame_time       = snapshot.frame_time;
+        sample.player_count            = static_cast<int32_t>(snapshot.players.size());
+        sample.max_player_num          = snapshot.max_player_num;
+        sample.wild_monster_count      = snapshot.wild_monster_count;
+        sample.otomo_monster_count     = snapshot.otomo_monster_count;
+        sample.base_camp_monster_count = snapshot.base_camp_monster_count;
+        sample.npc_count               = snapshot.npc_count;
+        sample.other_character_count   = snapshot.other_character_count;
+        sample.base_camp_count         = snapshot.base_camp_count;
+        sample.nav_mesh_invoker_count  = snapshot.nav_mesh_invoker_count;
+        return sample;
+    }
+
+    std::string write_frame(const WorldSnapshot &snapshot, std::optional<uint64_t> base_sequence) {
+        auto current = sample(snapshot);
+
+        remember(snapshot.sequence, current);
+
+        TelemetryHeader header {};
+        header.magic          = TelemetryMagic;
+        header.version        = TelemetrySchemaVersion;
+        header.sequence       = snapshot.sequence;
+        header.captured_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.captured_at.time_since_epoch()).count();
+
+        uint32_t fields[TelemetryNumFields];
+        std::memcpy(fields, &current, sizeof(current));
+
+        std::optional<TelemetrySample> base;
+        if (base_sequence) {
+            base = recall(*base_sequence);
+        }
+
+        std::string frame;
+        frame.resize(sizeof(header));
+
+        if (base) {
+            uint32_t base_fields[TelemetryNumFields];
+            std::memcpy(base_fields, &*base, sizeof(*base));
+
+            // compared bitwise, a float that didn't change keeps its bits
+            for (int i = 0; i < TelemetryNumFields; i++) {
+                if (fields[i] != base_fields[i]) {
+                    header.field_mask |= 1u << i;
+                    frame.append(reinterpret_cast<const char *>(&fields[i]), sizeof(uint32_t));
+                }
+            }
+
+            header.flags         = TelemetryDelta;
+            header.base_sequence = *base_sequence;
+        } else {
+            header.field_mask = (1u << TelemetryNumFields) - 1;
+            frame.append(reinterpret_cast<const char *>(&current), sizeof(current));
+        }
+
+        header.length = static_cast<uint32_t>(frame.size());
+        std::memcpy(frame.data(), &header, sizeof(header));
+        return frame;
+    }
+} // namespace telemetry
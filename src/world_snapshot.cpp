@@ -0,0 +1,313 @@
+#include "world_snapshot.h"
+#include "game_fields.h"
+#include "game_functions.h"
+#include "game_thread.h"
+#include "metrics.h"
+#include "spdlog/spdlog.h"
+#include "utils.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace world_snapshot {
+    namespace {
+        // one being written, one published, one for readers still holding the previous publish
+        constexpr int NumSlots = 3;
+
+        struct Slot {
+                WorldSnapshot         snapshot;
+                std::atomic<uint32_t> readers = 0;
+        };
+
+        Slot             slots[NumSlots];
+        std::atomic<int> current = -1;
+
+        std::shared_ptr<SDKContext>                  context;
+        std::atomic<bool>                            started     = false;
+        std::atomic<std::chrono::milliseconds::rep> interval_ms = 250;
+
+        // publish() is normally only called on the game thread, the lock covers the unattached fallback
+        std::mutex publish_lock;
+        uint64_t   sequence = 0;
+
+        // game thread only
+        uint32_t                              tick_calls = 0;
+        bool                                  publishing = false;
+        std::chrono::steady_clock::time_point last_publish;
+
+        constexpr const char *importance_names[] = { "all_update", "nearest", "near", "mid_in_sight", "far_in_sight", "mid_out_sight", "far_out_sight", "farthest" };
+
+        std::string fstring_to_utf8(const SDK::FString &text) {
+            return text.IsValid() ? utf16_to_utf8(text.Data, text.NumElements) : std::string();
+        }
+
+        // capture - reads the world into snapshot, reusing its strings and player vector
+        void capture(const SDKContext &ctx, WorldSnapshot &snapshot) {
+            auto state = ctx.stateInGame;
+
+            snapshot.captured_at    = std::chrono::system_clock::now();
+            snapshot.world_name     = game_functions::get_world_name(state).ToString();
+            snapshot.save_directory = APalGameStateInGame_WorldSaveDirectoryName.Get(state).ToString();
+            snapshot.frame_time     = game_functions::get_server_frame_time(state);
+            snapshot.max_player_num = game_functions::get_max_player_num(state);
+
+            snapshot.wild_monster_count      = APalGameStateInGame_ServerWildMonsterCount.Get(state);
+            snapshot.otomo_monster_count     = APalGameStateInGame_ServerOtomoMonsterCount.Get(state);
+            snapshot.base_camp_monster_count = APalGameStateInGame_ServerBaseCampMonsterCount.Get(state);
+            snapshot.npc_count               = APalGameStateInGame_ServerNPCCount.Get(state);
+            snapshot.other_character_count   = APalGameStateInGame_ServerOtherCharacterCount.Get(state);
+            snapshot.base_camp_count         = APalGameStateInGame_BaseCampCount.Get(state);
+            snapshot.nav_mesh_invoker_count  = APalGameStateInGame_NavMeshInvokerCount.Get(state);
+
+            snapshot.importance_character_count[0] = APalGameStateInGame_ImportanceCharacterCount_AllUpdate.Get(state);
+            snapshot.importance_character_count[1] = APalGameStateInGame_ImportanceCharacterCount_Nearest.Get(state);
+            snapshot.importance_character_count[2] = APalGameStateInGame_ImportanceCharacterCount_Near.Get(state);
+            snapshot.importance_character_count[3] = APalGameStateInGame_ImportanceCharacterCount_MidInSight.Get(state);
+            snapshot.importance_character_count[4] = APalGameStateInGame_ImportanceCharacterCount_FarInSight.Get(state);
+            snapshot.importance_character_count[5] = APalGameStateInGame_ImportanceCharacterCount_MidOutSight.Get(state);
+            snapshot.importance_character_count[6] = APalGameStateInGame_ImportanceCharacterCount_FarOutSight.Get(state);
+            snapshot.importance_character_count[7] = APalGameStateInGame_ImportanceCharacterCount_Farthest.Get(state);
+
+            // PlayerArray is read directly, a ProcessEvent per player [GetAllPlayerCharacters, GetPlayerName] adds up on a full server
+            auto  &player_states = state->PlayerArray;
+            size_t count         = 0;
+
+            snapshot.players.resize(player_states.IsValid() ? player_states.Num() : 0);
+
+            for (int i = 0; i < player_states.Num(); i++) {
+                auto player_state = player_states[i];
+
+                // players still logging in have no pawn yet, /players never listed them
+                if (!player_state || !player_state->PawnPrivate || !player_state->IsA(SDK::APalPlayerState::StaticClass())) {
+                    continue;
+                }
+
+                auto pal_state = static_cast<SDK::APalPlayerState *>(player_state);
+                auto guild     = APalPlayerState_GuildBelongTo.Get(pal_state);
+                auto &player   = snapshot.players[count++];
+
+                player.name      = fstring_to_utf8(player_state->PlayerNamePrivate);
+                player.guild     = guild ? fstring_to_utf8(UPalGroupGuildBase_GuildName.Get(guild)) : std::string();
+                player.address   = player_address(static_cast<SDK::APlayerController *>(player_state->Owner));
+                player.uid       = static_cast<uint32_t>(APalPlayerState_PlayerUId.Get(pal_state).A);
+                player.player_id = player_state->PlayerId;
+                player.ping_ms   = player_state->CompressedPing * 4; // replicated as ping / 4
+                player.location  = APalPlayerState_CachedPlayerLocation.Get(pal_state);
+            }
+
+            snapshot.players.resize(count);
+        }
+    } // namespace
+
+    SnapshotRef::SnapshotRef(SnapshotRef &&other) noexcept : slot(other.slot), snapshot(other.snapshot) {
+        other.slot     = -1;
+        other.snapshot = nullptr;
+    }
+
+    SnapshotRef &SnapshotRef::operator=(SnapshotRef &&other) noexcept {
+        if (this != &other) {
+            if (slot >= 0) {
+                slots[slot].readers.fetch_sub(1);
+            }
+
+            slot           = other.slot;
+            snapshot       = other.snapshot;
+            other.slot     = -1;
+            other.snapshot = nullptr;
+        }
+        return *this;
+    }
+
+    SnapshotRef::~SnapshotRef() {
+        if (slot >= 0) {
+            slots[slot].readers.fetch_sub(1);
+        }
+    }
+
+    void start(std::shared_ptr<SDKContext> in_context, std::chrono::milliseconds interval) {
+        context = std::move(in_context);
+        interval_ms.store(interval.count(), std::memory_order_relaxed);
+        started.store(true, std::memory_order_release);
+    }
+
+    void tick() {
+        if (!started.load(std::memory_order_acquire) || !game_thread::is_game_thread() || publishing) {
+            return;
+        }
+
+        // ProcessEvent runs thousands of times a frame, only look at the clock every 1024th call
+        if ((++tick_calls & 1023) != 0) {
+            return;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_publish < std::chrono::milliseconds(interval_ms.load(std::memory_order_relaxed))) {
+            return;
+        }
+
+        last_publish = now;
+        publish();
+    }
+
+    bool publish() {
+        if (!started.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        std::lock_guard lock(publish_lock);
+
+        // capture calls into the engine, which may come back through the ProcessEvent hook
+        publishing = true;
+
+        const int published = current.load();
+
+        for (int i = 0; i < NumSlots; i++) {
+            // a reader that raced us into this slot sees current != i and backs off before reading
+            if (i == published || slots[i].readers.load() != 0) {
+                continue;
+            }
+
+            auto capture_start = std::chrono::steady_clock::now();
+
+            try {
+                capture(*context, slots[i].snapshot);
+            } catch (std::exception const &e) {
+                spdlog::error("world snapshot failed: {}", e.what());
+                publishing = false;
+                return false;
+            }
+
+            metrics::world_snapshot_capture.record(std::chrono::steady_clock::now() - capture_start);
+
+            slots[i].snapshot.sequence = ++sequence;
+            current.store(i);
+
+            publishing = false;
+            return true;
+        }
+
+        // both spare slots are pinned by slow readers, keep serving the current snapshot
+        publishing = false;
+        return false;
+    }
+
+    SnapshotRef acquire() {
+        for (;;) {
+            const int slot = current.load();
+            if (slot < 0) {
+                return SnapshotRef();
+            }
+
+            slots[slot].readers.fetch_add(1);
+
+            // still published, the writer won't pick this slot until we let go
+            if (current.load() == slot) {
+                return SnapshotRef(slot, &slots[slot].snapshot);
+            }
+
+            slots[slot].readers.fetch_sub(1);
+        }
+    }
+
+    void write_player_json(const PlayerSnapshot &player, JsonWriter &json) {
+        json.begin_object();
+        json.field("name", player.name);
+        json.key("uid");
+        json.value_hex32(player.uid);
+        json.field("player_id", player.player_id);
+        json.field("address", player.address);
+        json.field("ping_ms", player.ping_ms);
+
+        json.key("guild");
+        if (player.guild.empty()) {
+            json.null();
+        } else {
+            json.value(player.guild);
+        }
+
+        json.key("location");
+        json.begin_object();
+        json.field("x", player.location.X);
+        json.field("y", player.location.Y);
+        json.field("z", player.location.Z);
+        json.end_object();
+
+        json.end_object();
+    }
+
+    void write_players_json(const WorldSnapshot &snapshot, JsonWriter &json) {
+        json.begin_object();
+        json.field("count", snapshot.players.size());
+        json.key("players");
+        json.begin_array();
+
+        for (auto &player : snapshot.players) {
+            write_player_json(player, json);
+        }
+
+        json.end_array();
+        json.end_object();
+    }
+
+    void write_state_json(const WorldSnapshot &snapshot, JsonWriter &json, bool per_snapshot) {
+        json.begin_object();
+        json.field("world_name", snapshot.world_name);
+        json.field("world_save_directory", snapshot.save_directory);
+        if (per_snapshot) {
+            json.field("server_frame_time", snapshot.frame_time);
+        }
+        json.field("max_player_num", snapshot.max_player_num);
+        json.field("player_count", snapshot.players.size());
+        json.field("wild_monster_count", snapshot.wild_monster_count);
+        json.field("otomo_monster_count", snapshot.otomo_monster_count);
+        json.field("base_camp_monster_count", snapshot.base_camp_monster_count);
+        json.field("npc_count", snapshot.npc_count);
+        json.field("other_character_count", snapshot.other_character_count);
+        json.field("base_camp_count", snapshot.base_camp_count);
+        json.field("nav_mesh_invoker_count", snapshot.nav_mesh_invoker_count);
+
+        json.key("importance_character_count");
+        json.begin_object();
+        for (int i = 0; i < 8; i++) {
+            json.field(importance_names[i], snapshot.importance_character_count[i]);
+        }
+        json.end_object();
+
+        if (per_snapshot) {
+            json.field("snapshot_sequence", snapshot.sequence);
+            json.field("snapshot_time_ms", std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.captured_at.time_since_epoch()).count());
+        }
+        json.end_object();
+    }
+} // namespace world_snapshot
+
+const PlayerSnapshot *WorldSnapshot::find_player(std::string_view uid_text) const {
+    if (uid_text.size() != 8) {
+        return nullptr;
+    }
+
+    uint32_t uid = 0;
+    for (char c : uid_text) {
+        uint32_t digit;
+
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return nullptr;
+        }
+
+        uid = uid << 4 | digit;
+    }
+
+    for (auto &player : players) {
+        if (player.uid == uid) {
+            return &player;
+        }
+    }
+
+    return nullptr;
+}
@@ -129,11 +129,37 @@ target("pal-plugin-loader")
     end
 
     add_files("src/*.cpp")
+    add_files("src/hooks/*.cpp")
     add_files("src/sdk/*.cpp")
 
 
+-- microbenchmarks, not built by default: xmake build process-event-bench && xmake run process-event-bench
+target("process-event-bench")
+    set_kind("binary")
+    set_default(false)
 
+    set_languages("c17", "cxx20")
+
+    if is_os("windows") then
+        add_cxxflags("/bigobj", "/wd4369", {force = true})
+        add_includedirs(path.join(os.scriptdir(), "include/os/windows/sdk"))
+    end
+
+    add_includedirs(path.join(os.scriptdir(), "include/sdk/sdk"))
+    add_includedirs(path.join(os.scriptdir(), "include/sdk"))
+    add_includedirs(path.join(os.scriptdir(), "include"))
+
+    add_files("bench/process_event_bench.cpp")
+    add_files("src/hooks/process_event_hooks.cpp")
 
+-- xmake build signature-scanner-bench && xmake run signature-scanner-bench
+target("signature-scanner-bench")
+    set_kind("binary")
+    set_default(false)
 
-    
+    set_languages("c17", "cxx20")
+
+    add_includedirs(path.join(os.scriptdir(), "include"))
 
+    add_files("bench/signature_scanner_bench.cpp")
+    add_files("src/signature_scanner.cpp")